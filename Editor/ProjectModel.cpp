@@ -596,10 +596,9 @@ void ProjectModel::importSongsData(const QString& path) {
 
 bool ProjectModel::reloadSampleData(const QString& groupName, UIMessenger&) {
   m_projectDatabase.setIdDatabases();
-  QString path = QFileInfo(m_dir, groupName).filePath();
   auto search = m_groups.find(groupName);
   if (search != m_groups.end())
-    search->second->getSdir().reloadSampleData(QStringToUTF8(path));
+    search->second->reloadSampleData();
 
   m_needsReset = true;
   return true;
@@ -77,6 +77,7 @@ std::pair<std::pair<qreal, qreal>, std::pair<qreal, qreal>> SampleView::iterateS
     uint32_t endRem = uint32_t(endSample) % 14;
 
     int16_t sampleBlock[14];
+    int16_t sampleBatch[14 * 64];
 
     if (startRem) {
       uint32_t end = 14;
@@ -92,17 +93,16 @@ std::pair<std::pair<qreal, qreal>, std::pair<qreal, qreal>> SampleView::iterateS
         ++startBlock;
     }
 
-    for (uint32_t b = startBlock; b < endBlock; ++b) {
-      DSPDecompressFrame(sampleBlock, m_sampleData + 8 * b, m_sample->m_ADPCMParms.dsp.m_coefs, &m_prev1, &m_prev2, 14);
-      for (uint32_t s = 0; s < 14; ++s)
-        accumulate(sampleBlock[s]);
-    }
-
-    if (endRem) {
-      DSPDecompressFrame(sampleBlock, m_sampleData + 8 * endBlock, m_sample->m_ADPCMParms.dsp.m_coefs, &m_prev1,
-                         &m_prev2, endRem);
-      for (uint32_t s = 0; s < endRem; ++s)
-        accumulate(sampleBlock[s]);
+    /* Decode whole frames and the trailing partial frame in batches */
+    uint32_t remSamples = (endBlock - startBlock) * 14 + endRem;
+    const uint8_t* cur = m_sampleData + 8 * startBlock;
+    while (remSamples) {
+      uint32_t thisSamples = std::min(remSamples, uint32_t(14 * 64));
+      DSPDecompressFrames(sampleBatch, cur, m_sample->m_ADPCMParms.dsp.m_coefs, &m_prev1, &m_prev2, thisSamples);
+      for (uint32_t s = 0; s < thisSamples; ++s)
+        accumulate(sampleBatch[s]);
+      remSamples -= thisSamples;
+      cur += 8 * (thisSamples / 14);
     }
   } else if (m_sample->getSampleFormat() == amuse::SampleFormat::PCM_PC) {
     for (uint32_t s = uint32_t(m_curSamplePos); s < uint32_t(endSample); ++s)
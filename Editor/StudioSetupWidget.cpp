@@ -7,6 +7,7 @@
 
 #include <amuse/EffectBase.hpp>
 #include <amuse/EffectChorus.hpp>
+#include <amuse/EffectConvolution.hpp>
 #include <amuse/EffectDelay.hpp>
 #include <amuse/EffectReverb.hpp>
 #include <amuse/Studio.hpp>
@@ -133,6 +134,24 @@ constexpr std::array<ChorusSetFunc, 3> ChorusSetters{
     &amuse::EffectChorus::setPeriod,
 };
 
+constexpr EffectIntrospection ConvolutionIntrospective = {
+    amuse::EffectType::Convolution,
+    "Convolution"sv,
+    "Convolution Reverb"sv,
+    {{
+        {EffectIntrospection::Field::Type::Float, "Mix"sv, 0.f, 1.f, 0.5f},
+    }},
+};
+
+using ConvolutionGetFunc = float (amuse::EffectConvolution::*)() const;
+using ConvolutionSetFunc = void (amuse::EffectConvolution::*)(float);
+constexpr std::array<ConvolutionGetFunc, 1> ConvolutionGetters{
+    &amuse::EffectConvolution::getMix,
+};
+constexpr std::array<ConvolutionSetFunc, 1> ConvolutionSetters{
+    &amuse::EffectConvolution::setMix,
+};
+
 constexpr const EffectIntrospection* GetEffectIntrospection(amuse::EffectType type) {
   switch (type) {
   case amuse::EffectType::ReverbStd:
@@ -143,6 +162,8 @@ constexpr const EffectIntrospection* GetEffectIntrospection(amuse::EffectType ty
     return &DelayIntrospective;
   case amuse::EffectType::Chorus:
     return &ChorusIntrospective;
+  case amuse::EffectType::Convolution:
+    return &ConvolutionIntrospective;
   default:
     return nullptr;
   }
@@ -159,6 +180,8 @@ T GetEffectParm(const amuse::EffectBaseTypeless* effect, int idx, int chanIdx) {
     return (static_cast<const amuse::EffectDelayImp<float>*>(effect)->*DelayGetters[idx])(chanIdx);
   case amuse::EffectType::Chorus:
     return (static_cast<const amuse::EffectChorusImp<float>*>(effect)->*ChorusGetters[idx])();
+  case amuse::EffectType::Convolution:
+    return (static_cast<const amuse::EffectConvolutionImp<float>*>(effect)->*ConvolutionGetters[idx])();
   default:
     return 0.f;
   }
@@ -179,6 +202,9 @@ void SetEffectParm(amuse::EffectBaseTypeless* effect, int idx, int chanIdx, T va
   case amuse::EffectType::Chorus:
     (static_cast<amuse::EffectChorusImp<float>*>(effect)->*ChorusSetters[idx])(val);
     break;
+  case amuse::EffectType::Convolution:
+    (static_cast<amuse::EffectConvolutionImp<float>*>(effect)->*ConvolutionSetters[idx])(val);
+    break;
   default:
     break;
   }
@@ -192,18 +218,20 @@ constexpr std::array<const char*, NumChanNames> ChanNames{
     QT_TRANSLATE_NOOP("Uint32X8Popup", "Side Left"),    QT_TRANSLATE_NOOP("Uint32X8Popup", "Side Right"),
 };
 
-constexpr std::array<const char*, 4> EffectStrings{
+constexpr std::array<const char*, 5> EffectStrings{
     QT_TRANSLATE_NOOP("EffectCatalogue", "Reverb Standard"),
     QT_TRANSLATE_NOOP("EffectCatalogue", "Reverb High"),
     QT_TRANSLATE_NOOP("EffectCatalogue", "Delay"),
     QT_TRANSLATE_NOOP("EffectCatalogue", "Chorus"),
+    QT_TRANSLATE_NOOP("EffectCatalogue", "Convolution"),
 };
 
-constexpr std::array<const char*, 4> EffectDocStrings{
+constexpr std::array<const char*, 5> EffectDocStrings{
     QT_TRANSLATE_NOOP("EffectCatalogue", "Reverb Standard"),
     QT_TRANSLATE_NOOP("EffectCatalogue", "Reverb High"),
     QT_TRANSLATE_NOOP("EffectCatalogue", "Delay"),
     QT_TRANSLATE_NOOP("EffectCatalogue", "Chorus"),
+    QT_TRANSLATE_NOOP("EffectCatalogue", "Convolution Reverb"),
 };
 } // Anonymous namespace
 
@@ -669,6 +697,9 @@ void EffectListing::insert(amuse::EffectType type, const QString& text) {
   case amuse::EffectType::Chorus:
     newEffect = m_submix->_makeEffect<amuse::EffectChorus>(amuse::EffectChorusInfo{});
     break;
+  case amuse::EffectType::Convolution:
+    newEffect = m_submix->_makeEffect<amuse::EffectConvolution>(amuse::EffectConvolutionInfo{});
+    break;
   default:
     break;
   }
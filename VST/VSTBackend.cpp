@@ -2,6 +2,7 @@
 #include "audiodev/AudioVoiceEngine.hpp"
 #include "logvisor/logvisor.hpp"
 #include <Shlobj.h>
+#include <algorithm>
 
 #undef min
 #undef max
@@ -135,18 +136,10 @@ VSTBackend::~VSTBackend() { editor = nullptr; }
 AEffEditor* VSTBackend::getEditor() { return &m_editor; }
 
 VstInt32 VSTBackend::processEvents(VstEvents* events) {
-  std::unique_lock<std::mutex> lk(m_lock);
+  /* The receiver feeds the MIDI reader's lock-free queue, so events (note-offs included) are never
+   * dropped while the UI thread holds m_lock; they play once processReplacing can pump again */
   VSTVoiceEngine& engine = static_cast<VSTVoiceEngine&>(*m_booBackend);
 
-  /* Handle group load request */
-  if (m_curGroup != m_reqGroup) {
-    m_curGroup = m_reqGroup;
-    if (m_curSeq)
-      m_curSeq->kill();
-    m_curSeq = m_engine->seqPlay(m_reqGroup, -1, nullptr);
-    m_editor.reselectPage();
-  }
-
   if (engine.m_midiReceiver) {
     for (VstInt32 i = 0; i < events->numEvents; ++i) {
       VstMidiEvent* evt = reinterpret_cast<VstMidiEvent*>(events->events[i]);
@@ -166,10 +159,16 @@ VstInt32 VSTBackend::processEvents(VstEvents* events) {
 }
 
 void VSTBackend::processReplacing(float**, float** outputs, VstInt32 sampleFrames) {
-  std::unique_lock<std::mutex> lk(m_lock);
+  std::unique_lock<std::mutex> lk(m_lock, std::try_to_lock);
+  if (!lk) {
+    for (int c = 0; c < 2; ++c)
+      std::fill(outputs[c], outputs[c] + sampleFrames, 0.f);
+    m_curFrame += sampleFrames;
+    return;
+  }
   VSTVoiceEngine& engine = static_cast<VSTVoiceEngine&>(*m_booBackend);
 
-  /* Output buffers */
+  /* Output buffers; queued group and program changes run at the start of the engine's next interval */
   engine.m_renderFrames = sampleFrames;
   engine.m_outputData = outputs;
   m_engine->pumpEngine();
@@ -236,13 +235,13 @@ void VSTBackend::setBlockSize(VstInt32 blockSize) {
 }
 
 void VSTBackend::loadGroupFile(int collectionIdx, int fileIdx) {
+  /* Adding a group fills m_groupTokens for the UI, so this one runs synchronously while the
+   * audio callbacks are locked out */
   std::unique_lock<std::mutex> lk(m_lock);
 
   if (m_curSeq) {
     m_curSeq->kill();
     m_curSeq.reset();
-    m_curGroup = -1;
-    m_reqGroup = -1;
   }
 
   if (collectionIdx < m_filePresenter.m_iteratorVec.size()) {
@@ -257,20 +256,17 @@ void VSTBackend::loadGroupFile(int collectionIdx, int fileIdx) {
   }
 }
 
-void VSTBackend::setGroup(int groupIdx, bool immediate) {
-  std::unique_lock<std::mutex> lk(m_lock);
-
+void VSTBackend::setGroup(int groupIdx) {
   if (!m_curData)
     return;
 
   if (groupIdx < m_curData->m_groupTokens.size()) {
-    const AudioGroupDataCollection::GroupToken& groupTok = m_curData->m_groupTokens[groupIdx];
-    m_reqGroup = groupTok.m_groupId;
-    if (immediate) {
+    const GroupId groupId = m_curData->m_groupTokens[groupIdx].m_groupId;
+    m_engine->getCommandQueue().post([this, groupId](Engine& engine) {
       if (m_curSeq)
         m_curSeq->kill();
-      m_curSeq = m_engine->seqPlay(groupTok.m_groupId, -1, nullptr);
-    }
+      m_curSeq = engine.seqPlay(groupId, -1, nullptr);
+    });
   }
 }
 
@@ -282,8 +278,7 @@ void VSTBackend::_setNormalProgram(int programNo) {
 }
 
 void VSTBackend::setNormalProgram(int programNo) {
-  std::unique_lock<std::mutex> lk(m_lock);
-  _setNormalProgram(programNo);
+  m_engine->getCommandQueue().post([this, programNo](Engine&) { _setNormalProgram(programNo); });
 }
 
 void VSTBackend::_setDrumProgram(int programNo) {
@@ -294,8 +289,7 @@ void VSTBackend::_setDrumProgram(int programNo) {
 }
 
 void VSTBackend::setDrumProgram(int programNo) {
-  std::unique_lock<std::mutex> lk(m_lock);
-  _setDrumProgram(programNo);
+  m_engine->getCommandQueue().post([this, programNo](Engine&) { _setDrumProgram(programNo); });
 }
 
 VstInt32 VSTBackend::getChunk(void** data, bool) {
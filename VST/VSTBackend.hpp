@@ -23,17 +23,15 @@ public:
 
 /** Actual plugin implementation class */
 class VSTBackend : public AudioEffectX {
-  std::mutex m_lock;
+  std::mutex m_lock; /**< Held by the UI thread while swapping group data; processReplacing only tries it */
   std::unique_ptr<boo::IAudioVoiceEngine> m_booBackend;
   std::optional<amuse::VSTBackendVoiceAllocator> m_voxAlloc;
   std::optional<amuse::Engine> m_engine;
-  std::shared_ptr<amuse::Sequencer> m_curSeq;
-  int m_reqGroup = -1;
-  int m_curGroup = -1;
+  ObjToken<Sequencer> m_curSeq; /**< Mixing thread only */
   const AudioGroupDataCollection* m_curData = nullptr;
   size_t m_curFrame = 0;
   std::wstring m_userDir;
-  int m_routeChannel = -1;
+  int m_routeChannel = -1; /**< Mixing thread only */
   AudioGroupFilePresenter m_filePresenter;
   VSTEditor m_editor;
 
@@ -59,7 +57,7 @@ public:
   AudioGroupFilePresenter& getFilePresenter() { return m_filePresenter; }
 
   void loadGroupFile(int collectionIdx, int fileIdx);
-  void setGroup(int groupIdx, bool immediate);
+  void setGroup(int groupIdx);
   void _setNormalProgram(int programNo);
   void setNormalProgram(int programNo);
   void _setDrumProgram(int programNo);
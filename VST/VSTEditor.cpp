@@ -252,7 +252,7 @@ void VSTEditor::update() {
   m_backend.getFilePresenter().populateCollectionColumn(*this);
   m_backend.loadGroupFile(m_selCollectionIdx, m_selFileIdx);
   m_backend.getFilePresenter().populateGroupColumn(*this, m_selCollectionIdx, m_selFileIdx);
-  m_backend.setGroup(m_selGroupIdx, true);
+  m_backend.setGroup(m_selGroupIdx);
   m_backend.getFilePresenter().populatePageColumn(*this, m_selCollectionIdx, m_selFileIdx, m_selGroupIdx);
   selectPage(m_selPageIdx);
   _reselectColumns();
@@ -323,7 +323,7 @@ void VSTEditor::selectCollection(LPARAM idx) {
 
 void VSTEditor::selectGroup(int idx) {
   m_selGroupIdx = idx;
-  m_backend.setGroup(m_selGroupIdx, false);
+  m_backend.setGroup(m_selGroupIdx);
   m_backend.getFilePresenter().populatePageColumn(*this, m_selCollectionIdx, m_selFileIdx, m_selGroupIdx);
   m_lastLParam = -1;
 }
@@ -344,9 +344,9 @@ void VSTEditor::selectPage(int idx) {
 void VSTEditor::reselectPage() {
   if (m_lastLParam != -1) {
     if (m_lastLParam & 0x80000000)
-      m_backend._setDrumProgram(m_lastLParam & 0x7fffffff);
+      m_backend.setDrumProgram(m_lastLParam & 0x7fffffff);
     else
-      m_backend._setNormalProgram(m_lastLParam & 0x7fffffff);
+      m_backend.setNormalProgram(m_lastLParam & 0x7fffffff);
   }
 }
 
@@ -0,0 +1,564 @@
+#include "amuse/amuse.hpp"
+#include "amuse/DSPCodec.hpp"
+#include "amuse/N64MusyXCodec.hpp"
+#include "logvisor/logvisor.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if _WIN32
+#include <nowide/args.hpp>
+#endif
+
+static logvisor::Module Log("amuse-bench");
+
+/* Keeps benchmarked results observable so the optimizer cannot discard them */
+static volatile uint32_t g_Sink = 0;
+
+namespace {
+
+constexpr double OutputRate = 48000.0;
+constexpr size_t BlockFrames = 240; /* 5ms at OutputRate */
+constexpr uint16_t SampleRate = 32000;
+constexpr size_t SampleLength = 14 * 1024; /* Whole DSP frames; also a multiple of VADPCM's 64 */
+
+struct BenchResult {
+  std::string m_name;
+  std::string m_unit;
+  size_t m_iterations;
+  double m_nsPerIter;
+  double m_itemsPerSec;
+  double m_worstNs; /**< slowest single iteration, or 0 when not measured */
+};
+
+/** Times callables until stable and collects results for JSON output */
+class BenchRunner {
+  double m_minTime;
+  std::string_view m_filter;
+  std::vector<BenchResult> m_results;
+
+  static double Elapsed(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+public:
+  BenchRunner(double minTime, std::string_view filter) : m_minTime(minTime), m_filter(filter) {}
+
+  /** Runs `func` (one iteration processing `itemsPerIter` units) and records the median of 5 timed runs.
+   *  A nonzero `worstPeriod` also times every iteration and records the worst one, taking the best of the runs
+   *  at each position within that period of iterations so scheduler noise does not stand in for a real peak. */
+  template <typename Func>
+  void run(std::string name, size_t itemsPerIter, std::string_view unit, Func&& func, size_t worstPeriod = 0) {
+    if (!m_filter.empty() && name.find(m_filter) == std::string::npos)
+      return;
+
+    /* Warm caches, then grow the iteration count until one run covers a fifth of the time budget */
+    func();
+    size_t iterations = 1;
+    for (;;) {
+      const auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < iterations; ++i)
+        func();
+      if (Elapsed(start) >= m_minTime / 5.0)
+        break;
+      iterations *= 2;
+    }
+    if (worstPeriod)
+      iterations = (iterations + worstPeriod - 1) / worstPeriod * worstPeriod;
+
+    std::array<double, 5> runs;
+    std::vector<double> best(worstPeriod, std::numeric_limits<double>::max());
+    for (double& run : runs) {
+      const auto start = std::chrono::steady_clock::now();
+      if (worstPeriod) {
+        for (size_t i = 0; i < iterations; ++i) {
+          const auto iterStart = std::chrono::steady_clock::now();
+          func();
+          best[i % worstPeriod] = std::min(best[i % worstPeriod], Elapsed(iterStart) * 1e9);
+        }
+      } else {
+        for (size_t i = 0; i < iterations; ++i)
+          func();
+      }
+      run = Elapsed(start) * 1e9 / double(iterations);
+    }
+    std::sort(runs.begin(), runs.end());
+
+    const double nsPerIter = runs[runs.size() / 2];
+    const double worstNs = worstPeriod ? *std::max_element(best.begin(), best.end()) : 0.0;
+    m_results.push_back({std::move(name), std::string(unit), iterations, nsPerIter,
+                         nsPerIter > 0.0 ? double(itemsPerIter) * 1e9 / nsPerIter : 0.0, worstNs});
+    const BenchResult& res = m_results.back();
+    fmt::print(stderr, FMT_STRING("{:<40} {:>12.1f} ns/iter {:>14.0f} {}/s"), res.m_name, res.m_nsPerIter,
+               res.m_itemsPerSec, res.m_unit);
+    if (worstPeriod)
+      fmt::print(stderr, FMT_STRING(" {:>12.1f} ns worst"), res.m_worstNs);
+    fmt::print(stderr, FMT_STRING("\n"));
+  }
+
+  void writeJSON(FILE* fp) const {
+    fmt::print(fp, FMT_STRING("{{\n  \"benchmarks\": [\n"));
+    for (size_t i = 0; i < m_results.size(); ++i) {
+      const BenchResult& res = m_results[i];
+      fmt::print(fp,
+                 FMT_STRING("    {{\"name\": \"{}\", \"unit\": \"{}\", \"iterations\": {}, \"ns_per_iter\": {:.3f}, "
+                            "\"items_per_sec\": {:.1f}"),
+                 res.m_name, res.m_unit, res.m_iterations, res.m_nsPerIter, res.m_itemsPerSec);
+      if (res.m_worstNs > 0.0)
+        fmt::print(fp, FMT_STRING(", \"worst_ns\": {:.3f}"), res.m_worstNs);
+      fmt::print(fp, FMT_STRING("}}{}\n"), i + 1 < m_results.size() ? "," : "");
+    }
+    fmt::print(fp, FMT_STRING("  ]\n}}\n"));
+  }
+};
+
+/** Deterministic test tone: a few partials plus a little noise */
+std::vector<int16_t> MakePCM(size_t samples) {
+  std::minstd_rand rand(1234);
+  std::uniform_real_distribution<float> noise(-0.02f, 0.02f);
+  std::vector<int16_t> ret(samples);
+  for (size_t i = 0; i < samples; ++i) {
+    const float t = float(i) / SampleRate;
+    const float val = 0.5f * std::sin(t * 440.f * 6.2831853f) + 0.2f * std::sin(t * 1320.f * 6.2831853f) +
+                      0.1f * std::sin(t * 3960.f * 6.2831853f) + noise(rand);
+    ret[i] = int16_t(std::clamp(val, -1.f, 1.f) * 32767.f);
+  }
+  return ret;
+}
+
+amuse::ChannelMap MakeChannelMap(unsigned channels) {
+  static constexpr amuse::AudioChannel Order[] = {
+      amuse::AudioChannel::FrontLeft, amuse::AudioChannel::FrontRight, amuse::AudioChannel::FrontCenter,
+      amuse::AudioChannel::LFE,       amuse::AudioChannel::RearLeft,   amuse::AudioChannel::RearRight,
+      amuse::AudioChannel::SideLeft,  amuse::AudioChannel::SideRight};
+  amuse::ChannelMap ret;
+  ret.m_channelCount = channels;
+  for (unsigned i = 0; i < channels; ++i)
+    ret.m_channels[i] = Order[i];
+  return ret;
+}
+
+/** Codec data shared by the codec and voice benchmarks */
+struct CodecData {
+  std::vector<int16_t> m_pcm = MakePCM(SampleLength);
+  int16_t m_dspCoefs[8][2];
+  std::vector<uint8_t> m_dsp;
+  int16_t m_vadpcmCoefs[8][2][8];
+  std::vector<uint8_t> m_vadpcm;
+
+  CodecData() {
+    DSPCorrelateCoefs(m_pcm.data(), int(m_pcm.size()), m_dspCoefs);
+    m_dsp.resize(m_pcm.size() / 14 * 8);
+    int16_t frame[16] = {};
+    for (size_t f = 0; f < m_pcm.size() / 14; ++f) {
+      /* Encoder expects the previous two samples ahead of the frame */
+      std::memcpy(frame + 2, m_pcm.data() + f * 14, 14 * sizeof(int16_t));
+      DSPEncodeFrame(frame, 14, m_dsp.data() + f * 8, m_dspCoefs);
+      frame[0] = frame[14];
+      frame[1] = frame[15];
+    }
+
+    /* No VADPCM encoder exists in-tree; random frames with a mild codebook exercise the same decode path */
+    std::minstd_rand rand(5678);
+    std::uniform_int_distribution<int> coef(-1024, 1024);
+    for (auto& entry : m_vadpcmCoefs)
+      for (auto& order : entry)
+        for (int16_t& c : order)
+          c = int16_t(coef(rand));
+    m_vadpcm.resize(m_pcm.size() / 64 * 40);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (uint8_t& b : m_vadpcm)
+      b = uint8_t(byte(rand));
+  }
+};
+
+void BenchCodecs(BenchRunner& runner, const CodecData& data) {
+  const size_t dspFrames = data.m_dsp.size() / 8;
+  const size_t vadpcmBlocks = data.m_vadpcm.size() / 40;
+  std::vector<int16_t> out(SampleLength + 64);
+
+  runner.run("codec/dsp_decompress_frame", SampleLength, "samples", [&]() {
+    int16_t prev1 = 0, prev2 = 0;
+    for (size_t f = 0; f < dspFrames; ++f)
+      DSPDecompressFrame(out.data() + f * 14, data.m_dsp.data() + f * 8, data.m_dspCoefs, &prev1, &prev2, 14);
+    g_Sink = g_Sink + uint16_t(prev1);
+  });
+
+  runner.run("codec/dsp_decompress_frames", SampleLength, "samples", [&]() {
+    int16_t prev1 = 0, prev2 = 0;
+    DSPDecompressFrames(out.data(), data.m_dsp.data(), data.m_dspCoefs, &prev1, &prev2, SampleLength);
+    g_Sink = g_Sink + uint16_t(prev1);
+  });
+
+  runner.run("codec/dsp_encode_frame", SampleLength, "samples", [&]() {
+    int16_t frame[16] = {};
+    uint8_t adpcm[8];
+    for (size_t f = 0; f < dspFrames; ++f) {
+      std::memcpy(frame + 2, data.m_pcm.data() + f * 14, 14 * sizeof(int16_t));
+      DSPEncodeFrame(frame, 14, adpcm, data.m_dspCoefs);
+      frame[0] = frame[14];
+      frame[1] = frame[15];
+    }
+    g_Sink = g_Sink + adpcm[0];
+  });
+
+  runner.run("codec/dsp_correlate_coefs", SampleLength, "samples", [&]() {
+    int16_t coefs[8][2];
+    DSPCorrelateCoefs(data.m_pcm.data(), int(data.m_pcm.size()), coefs);
+    g_Sink = g_Sink + uint16_t(coefs[0][0]);
+  });
+
+  runner.run("codec/n64_decompress_frame", vadpcmBlocks * 64, "samples", [&]() {
+    for (size_t b = 0; b < vadpcmBlocks; ++b)
+      N64MusyXDecompressFrame(out.data() + b * 64, data.m_vadpcm.data() + b * 40, data.m_vadpcmCoefs, 64);
+    g_Sink = g_Sink + uint16_t(out[0]);
+  });
+
+  const N64MusyXPredictor pred(data.m_vadpcmCoefs);
+  runner.run("codec/n64_decompress_frame_predictor", vadpcmBlocks * 64, "samples", [&]() {
+    for (size_t b = 0; b < vadpcmBlocks; ++b)
+      N64MusyXDecompressFrame(out.data() + b * 64, data.m_vadpcm.data() + b * 40, pred, 64);
+    g_Sink = g_Sink + uint16_t(out[0]);
+  });
+}
+
+void BenchResampler(BenchRunner& runner, const std::vector<int16_t>& pcm) {
+  static constexpr std::pair<amuse::ResamplerQuality, std::string_view> Qualities[] = {
+      {amuse::ResamplerQuality::Linear, "linear"},
+      {amuse::ResamplerQuality::Cubic, "cubic"},
+      {amuse::ResamplerQuality::Sinc, "sinc"},
+  };
+  /* Voice rate pitched up a few semitones, as a typical note would be */
+  const double step = SampleRate / OutputRate * 1.26;
+  std::vector<float> out(BlockFrames);
+  for (const auto& [quality, name] : Qualities) {
+    amuse::Resampler resampler(quality);
+    size_t pcmPos = 0;
+    runner.run(fmt::format(FMT_STRING("resample/{}"), name), BlockFrames, "frames", [&]() {
+      const size_t need = resampler.inputNeeded(BlockFrames, step);
+      if (pcmPos + need > pcm.size())
+        pcmPos = 0;
+      resampler.pushInput(pcm.data() + pcmPos, need);
+      pcmPos += need;
+      resampler.process(out.data(), BlockFrames, step);
+      g_Sink = g_Sink + uint32_t(out[0] * 32768.f);
+    });
+  }
+}
+
+template <typename T>
+struct SampleTraits;
+template <>
+struct SampleTraits<int16_t> {
+  static constexpr std::string_view Name = "s16";
+  static int16_t From(float v) { return int16_t(v * 32767.f); }
+};
+template <>
+struct SampleTraits<int32_t> {
+  static constexpr std::string_view Name = "s32";
+  static int32_t From(float v) { return int32_t(v * 8388607.f); }
+};
+template <>
+struct SampleTraits<float> {
+  static constexpr std::string_view Name = "f32";
+  static float From(float v) { return v; }
+};
+
+template <typename T>
+void BenchEffect(BenchRunner& runner, std::string_view effectName, amuse::EffectBase<T>& effect, unsigned channels,
+                 const std::vector<int16_t>& pcm, size_t worstPeriod = 0) {
+  const amuse::ChannelMap chanMap = MakeChannelMap(channels);
+  std::vector<T> source(BlockFrames * channels);
+  for (size_t f = 0; f < BlockFrames; ++f)
+    for (unsigned c = 0; c < channels; ++c)
+      source[f * channels + c] = SampleTraits<T>::From(pcm[(f * 3 + c * 17) % pcm.size()] / 32768.f * 0.5f);
+
+  std::vector<T> buf(source.size());
+  runner.run(fmt::format(FMT_STRING("effect/{}/{}/{}ch"), effectName, SampleTraits<T>::Name, channels), BlockFrames,
+             "frames", [&]() {
+               std::copy(source.begin(), source.end(), buf.begin());
+               effect.applyEffect(buf.data(), BlockFrames, chanMap);
+               g_Sink = g_Sink + uint32_t(buf[0]);
+             },
+             worstPeriod);
+}
+
+template <typename T>
+void BenchEffectsOfType(BenchRunner& runner, const std::vector<int16_t>& pcm) {
+  for (unsigned channels : {2u, 6u, 8u}) {
+    amuse::EffectReverbStdImp<T> reverbStd(0.5f, 0.5f, 3.f, 0.5f, 0.05f, OutputRate);
+    BenchEffect<T>(runner, "reverb_std", reverbStd, channels, pcm);
+    amuse::EffectReverbHiImp<T> reverbHi(0.5f, 0.5f, 3.f, 0.5f, 0.05f, 0.5f, OutputRate);
+    BenchEffect<T>(runner, "reverb_hi", reverbHi, channels, pcm);
+    amuse::EffectChorusImp<T> chorus(10, 3, 1500, OutputRate);
+    BenchEffect<T>(runner, "chorus", chorus, channels, pcm);
+    amuse::EffectDelayImp<T> delay(300, 50, 80, OutputRate);
+    BenchEffect<T>(runner, "delay", delay, channels, pcm);
+  }
+
+  /* Stereo IRs of decaying noise. Large partitions only line up with blocks every lcm(BlockFrames, MaxPartition)
+   * frames, so the worst block is taken over that many blocks. */
+  constexpr size_t ConvPeriod =
+      amuse::EffectConvolution::MaxPartition / std::gcd(BlockFrames, size_t(amuse::EffectConvolution::MaxPartition));
+  for (unsigned seconds : {2u, 10u}) {
+    const size_t irFrames = size_t(OutputRate) * seconds;
+    std::minstd_rand rand(seconds);
+    std::uniform_real_distribution<float> noise(-1.f, 1.f);
+    std::vector<float> ir(irFrames * 2);
+    for (size_t i = 0; i < ir.size(); ++i)
+      ir[i] = noise(rand) * std::exp(-6.9f * float(i / 2) / float(irFrames));
+
+    for (unsigned channels : {2u, 8u}) {
+      amuse::EffectConvolutionImp<T> convolution(0.5f, OutputRate);
+      convolution.setIR(ir.data(), irFrames, 2, OutputRate);
+      while (convolution.getIRState() == amuse::ConvolutionIRState::Preparing)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      BenchEffect<T>(runner, fmt::format(FMT_STRING("convolution_{}s"), seconds), convolution, channels, pcm,
+                     ConvPeriod);
+    }
+  }
+}
+
+/** Hand-built group whose sample data lives in the benchmark rather than a SAMP chunk */
+class BenchGroup : public amuse::AudioGroup {
+public:
+  explicit BenchGroup(const unsigned char* samp) {
+    m_samp = samp;
+    m_valid = true;
+  }
+};
+
+void BenchVoices(BenchRunner& runner, const CodecData& data) {
+  /* Lay out each format as it appears in a SAMP chunk; VADPCM blocks follow a 256-byte codebook area */
+  std::vector<uint8_t> samp;
+  const auto dspOff = uint32_t(samp.size());
+  samp.insert(samp.end(), data.m_dsp.begin(), data.m_dsp.end());
+  const auto n64Off = uint32_t(samp.size());
+  samp.resize(samp.size() + 256);
+  samp.insert(samp.end(), data.m_vadpcm.begin(), data.m_vadpcm.end());
+  const auto pcmOff = uint32_t(samp.size());
+  samp.insert(samp.end(), reinterpret_cast<const uint8_t*>(data.m_pcm.data()),
+              reinterpret_cast<const uint8_t*>(data.m_pcm.data() + data.m_pcm.size()));
+
+  BenchGroup group(samp.data());
+  auto addSample = [&](amuse::SampleId id, amuse::SampleFormat format, uint32_t offset) {
+    amuse::ObjToken<amuse::SampleEntry> entry = amuse::MakeObj<amuse::SampleEntry>();
+    amuse::SampleEntryData& ent = *entry->m_data;
+    ent.m_sampleOff = offset;
+    ent.m_pitch = 60;
+    ent.m_sampleRate = SampleRate;
+    ent.m_numSamples = (uint32_t(format) << 24) | uint32_t(SampleLength);
+    ent.m_loopStartSample = 0;
+    ent.m_loopLengthSamples = SampleLength;
+    if (format == amuse::SampleFormat::DSP) {
+      ent.m_ADPCMParms.dsp.m_bytesPerFrame = 8;
+      std::memcpy(ent.m_ADPCMParms.dsp.m_coefs, data.m_dspCoefs, sizeof(data.m_dspCoefs));
+    } else if (format == amuse::SampleFormat::N64) {
+      std::memcpy(ent.m_ADPCMParms.vadpcm.m_coefs, data.m_vadpcmCoefs, sizeof(data.m_vadpcmCoefs));
+      ent.buildVADPCMPredictor();
+    }
+    group.getSdir().sampleEntries()[id] = std::move(entry);
+  };
+
+  struct Format {
+    std::string_view m_name;
+    amuse::SampleId m_id;
+  };
+  const Format formats[] = {{"dsp", amuse::SampleId(1)}, {"n64", amuse::SampleId(2)}, {"pcm", amuse::SampleId(3)}};
+  addSample(formats[0].m_id, amuse::SampleFormat::DSP, dspOff);
+  addSample(formats[1].m_id, amuse::SampleFormat::N64, n64Off);
+  addSample(formats[2].m_id, amuse::SampleFormat::PCM_PC, pcmOff);
+
+  for (const Format& format : formats) {
+    /* StartSample on a looped sample, then hold indefinitely */
+    amuse::SoundMacro macro;
+    auto* start =
+        static_cast<amuse::SoundMacro::CmdStartSample*>(macro.insertNewCmd(0, amuse::SoundMacro::CmdOp::StartSample));
+    start->sample.id = format.m_id;
+    start->mode = amuse::SoundMacro::CmdStartSample::Mode::NoScale;
+    start->offset = 0;
+    auto* wait =
+        static_cast<amuse::SoundMacro::CmdWaitTicks*>(macro.insertNewCmd(1, amuse::SoundMacro::CmdOp::WaitTicks));
+    wait->keyOff = false;
+    wait->sampleEnd = false;
+    wait->ticksOrMs = 65535;
+    macro.insertNewCmd(2, amuse::SoundMacro::CmdOp::End);
+
+    for (size_t numVoices : {1, 16, 64, 256}) {
+      amuse::OfflineBackendVoiceAllocator backend(OutputRate, amuse::AudioChannelSet::Stereo);
+      amuse::Engine engine(backend, amuse::AmplitudeMode::PerSample, numVoices);
+      for (size_t i = 0; i < numVoices; ++i)
+        engine.macroStart(&group, &macro, uint8_t(48 + i % 24), 100, 0);
+
+      std::vector<float> out(BlockFrames * backend.getChannelCount());
+      runner.run(fmt::format(FMT_STRING("voice/{}/{}"), format.m_name, numVoices), BlockFrames * numVoices,
+                 "voice_frames", [&]() {
+                   backend.pumpAndMix(out.data(), BlockFrames);
+                   g_Sink = g_Sink + uint32_t(out[0] * 32768.f);
+                 });
+    }
+  }
+}
+
+/** Type-1 SMF with `tracks` busy channels: notes every 8th, controller and pitch-wheel sweeps every 16th */
+std::vector<uint8_t> MakeSyntheticMIDI(unsigned tracks, unsigned bars) {
+  constexpr uint16_t Division = 384;
+  std::vector<uint8_t> ret;
+  auto put32 = [](std::vector<uint8_t>& buf, uint32_t val) {
+    for (int s = 24; s >= 0; s -= 8)
+      buf.push_back(uint8_t(val >> s));
+  };
+  auto putVLQ = [](std::vector<uint8_t>& buf, uint32_t val) {
+    uint8_t tmp[5];
+    int len = 0;
+    do {
+      tmp[len++] = uint8_t(val & 0x7f);
+      val >>= 7;
+    } while (val);
+    while (len--)
+      buf.push_back(uint8_t(tmp[len] | (len ? 0x80 : 0)));
+  };
+  auto addTrack = [&](const std::vector<uint8_t>& events) {
+    ret.insert(ret.end(), {'M', 'T', 'r', 'k'});
+    put32(ret, uint32_t(events.size()));
+    ret.insert(ret.end(), events.begin(), events.end());
+  };
+
+  ret.insert(ret.end(), {'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1});
+  ret.push_back(uint8_t((tracks + 1) >> 8));
+  ret.push_back(uint8_t(tracks + 1));
+  ret.push_back(uint8_t(Division >> 8));
+  ret.push_back(uint8_t(Division));
+
+  /* Tempo track: 120 BPM */
+  addTrack({0x00, 0xff, 0x51, 0x03, 0x07, 0xa1, 0x20, 0x00, 0xff, 0x2f, 0x00});
+
+  const uint32_t sixteenths = bars * 16;
+  for (unsigned t = 0; t < tracks; ++t) {
+    std::vector<uint8_t> ev;
+    const auto chan = uint8_t(t % 16);
+    for (uint32_t s = 0; s < sixteenths; ++s) {
+      putVLQ(ev, s ? Division / 4 : 0);
+      ev.insert(ev.end(), {uint8_t(0xb0 | chan), 7, uint8_t(64 + (s * 5 + t) % 64)});
+      putVLQ(ev, 0);
+      const auto bend = uint16_t(8192 + int(std::sin(s * 0.3f + t) * 4000.f));
+      ev.insert(ev.end(), {uint8_t(0xe0 | chan), uint8_t(bend & 0x7f), uint8_t(bend >> 7)});
+      if (s % 2 == 0) {
+        putVLQ(ev, 0);
+        ev.insert(ev.end(), {uint8_t(0x90 | chan), uint8_t(48 + (s * 7 + t * 3) % 36), 100});
+      } else {
+        putVLQ(ev, 0);
+        ev.insert(ev.end(), {uint8_t(0x80 | chan), uint8_t(48 + ((s - 1) * 7 + t * 3) % 36), 0});
+      }
+    }
+    ev.insert(ev.end(), {0x00, 0xff, 0x2f, 0x00});
+    addTrack(ev);
+  }
+  return ret;
+}
+
+void BenchSongState(BenchRunner& runner) {
+  /* Song group without a MIDI setup: channels resolve no pages, so time stays in SongState dispatch */
+  BenchGroup group(nullptr);
+  group.getProj().songGroups()[amuse::GroupId(1)] = amuse::MakeObj<amuse::SongGroupIndex>();
+
+  amuse::OfflineBackendVoiceAllocator backend(OutputRate, amuse::AudioChannelSet::Stereo);
+  amuse::Engine engine(backend);
+  amuse::ObjToken<amuse::Sequencer> seq =
+      engine.seqPlay(&group, amuse::GroupId(1), amuse::SongId(0), nullptr, false);
+  if (!seq) {
+    Log.report(logvisor::Error, FMT_STRING("unable to create sequencer for song benchmarks"));
+    return;
+  }
+
+  for (unsigned tracks : {1u, 8u, 16u}) {
+    for (int version : {0, 1}) {
+      const std::vector<uint8_t> song =
+          amuse::SongConverter::MIDIToSong(MakeSyntheticMIDI(tracks, 64), version, true);
+      if (song.empty()) {
+        Log.report(logvisor::Error, FMT_STRING("unable to convert synthetic song"));
+        continue;
+      }
+
+      /* One iteration is one 5ms engine interval; the song restarts whenever it ends */
+      amuse::SongState state;
+      state.initialize(song.data(), false);
+      constexpr double dt = BlockFrames / OutputRate;
+      runner.run(fmt::format(FMT_STRING("song/v{}/{}tracks"), version, tracks), 1, "intervals", [&]() {
+        if (state.advance(*seq, dt))
+          state.initialize(song.data(), false);
+      });
+    }
+  }
+}
+
+} // anonymous namespace
+
+#if _WIN32
+int wmain(int argc, const wchar_t** wargv)
+#else
+int main(int argc, const char** argv)
+#endif
+{
+#if _WIN32
+  nowide::args _(argc, argv);
+#endif
+  logvisor::RegisterConsoleLogger();
+
+  double minTime = 0.5;
+  std::string filter;
+  std::string outPath;
+  for (int i = 1; i < argc; ++i) {
+    if (!strncmp(argv[i], "-t", 2)) {
+      if (argv[i][2])
+        minTime = strtod(&argv[i][2], nullptr);
+      else if (argc > (i + 1)) {
+        minTime = strtod(argv[i + 1], nullptr);
+        ++i;
+      }
+    } else if (!strncmp(argv[i], "-o", 2)) {
+      if (argv[i][2])
+        outPath = &argv[i][2];
+      else if (argc > (i + 1)) {
+        outPath = argv[i + 1];
+        ++i;
+      }
+    } else if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help")) {
+      Log.report(logvisor::Info,
+                 FMT_STRING("Usage: amuse-bench [<name-filter>] [-t <seconds-per-benchmark>] [-o <json-file>]"));
+      return 0;
+    } else
+      filter = argv[i];
+  }
+
+  BenchRunner runner(std::max(minTime, 0.01), filter);
+  const CodecData data;
+  BenchCodecs(runner, data);
+  BenchResampler(runner, data.m_pcm);
+  BenchEffectsOfType<int16_t>(runner, data.m_pcm);
+  BenchEffectsOfType<int32_t>(runner, data.m_pcm);
+  BenchEffectsOfType<float>(runner, data.m_pcm);
+  BenchVoices(runner, data);
+  BenchSongState(runner);
+
+  FILE* fp = outPath.empty() ? stdout : amuse::FOpen(outPath.c_str(), "w");
+  if (!fp) {
+    Log.report(logvisor::Error, FMT_STRING("unable to open {} for writing"), outPath);
+    return 1;
+  }
+  runner.writeJSON(fp);
+  if (fp != stdout)
+    fclose(fp);
+  return 0;
+}
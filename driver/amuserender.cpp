@@ -14,6 +14,14 @@
 #include <vector>
 #include <unordered_map>
 #include <cstdarg>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <sstream>
 
 static logvisor::Module Log("amuserender");
 
@@ -65,10 +73,249 @@ static void abortHandler(int signum) {
 }
 #endif
 
-/* SIGINT will gracefully break write loop */
-static bool g_BreakLoop = false;
+/* SIGINT will gracefully break write loop (read by batch workers, hence atomic) */
+static std::atomic_bool g_BreakLoop = false;
 static void SIGINTHandler(int sig) { g_BreakLoop = true; }
 
+/* Batch mode: renders every (group, song, setup) job of a manifest concurrently,
+ * one Engine and offline backend per worker over shared read-only group data */
+namespace {
+
+struct BatchContainer {
+  std::vector<std::pair<std::string, amuse::IntrusiveAudioGroupData>> m_data;
+  std::list<amuse::AudioGroupProject> m_projs;
+  std::vector<std::pair<std::string, amuse::ContainerRegistry::SongData>> m_songs;
+};
+
+struct BatchJob {
+  const amuse::IntrusiveAudioGroupData* m_data;
+  const unsigned char* m_arrData;
+  std::string m_groupName;
+  std::string m_songName;
+  int m_groupId;
+  int m_setupId;
+  std::string m_pathOut;
+};
+
+bool GlobMatch(const char* pattern, const char* str) {
+  if (*pattern == '\0')
+    return *str == '\0';
+  if (*pattern == '*')
+    return GlobMatch(pattern + 1, str) || (*str && GlobMatch(pattern, str + 1));
+  if (*str && (*pattern == '?' || *pattern == *str))
+    return GlobMatch(pattern + 1, str + 1);
+  return false;
+}
+
+amuse::AudioChannelSet ChannelSetForCount(int chCount) {
+  switch (chCount) {
+  case 4:
+    return amuse::AudioChannelSet::Quad;
+  case 6:
+    return amuse::AudioChannelSet::Surround51;
+  case 8:
+    return amuse::AudioChannelSet::Surround71;
+  default:
+    return amuse::AudioChannelSet::Stereo;
+  }
+}
+
+/* Minimal 16-bit PCM WAV writer; sizes are patched on close */
+class WAVWriter {
+  FILE* m_fp;
+  uint32_t m_dataBytes = 0;
+
+  void writeU32(uint32_t val) { fwrite(&val, 4, 1, m_fp); }
+  void writeU16(uint16_t val) { fwrite(&val, 2, 1, m_fp); }
+
+public:
+  WAVWriter(const std::string& path, uint32_t rate, uint16_t chCount) : m_fp(fopen(path.c_str(), "wb")) {
+    if (!m_fp)
+      return;
+    fwrite("RIFF", 1, 4, m_fp);
+    writeU32(0);
+    fwrite("WAVEfmt ", 1, 8, m_fp);
+    writeU32(16);
+    writeU16(1);
+    writeU16(chCount);
+    writeU32(rate);
+    writeU32(rate * chCount * 2);
+    writeU16(chCount * 2);
+    writeU16(16);
+    fwrite("data", 1, 4, m_fp);
+    writeU32(0);
+  }
+  ~WAVWriter() {
+    if (!m_fp)
+      return;
+    fseek(m_fp, 4, SEEK_SET);
+    writeU32(36 + m_dataBytes);
+    fseek(m_fp, 40, SEEK_SET);
+    writeU32(m_dataBytes);
+    fclose(m_fp);
+  }
+  explicit operator bool() const { return m_fp != nullptr; }
+  void write(const float* samps, size_t count) {
+    int16_t buf[1024];
+    while (count) {
+      const size_t n = std::min(count, std::size(buf));
+      for (size_t i = 0; i < n; ++i)
+        buf[i] = int16_t(std::clamp(samps[i] * 32768.f, -32768.f, 32767.f));
+      fwrite(buf, 2, n, m_fp);
+      m_dataBytes += uint32_t(n * 2);
+      samps += n;
+      count -= n;
+    }
+  }
+};
+
+/* Manifest lines: <group-file> [<songs-file>|-] [<song-glob>] [<setup-id>]; '#' starts a comment.
+ * Entries that fail to load or resolve, or would rewrite an earlier job's output, are counted in skipped */
+bool LoadBatchManifest(const std::string& path, std::map<std::string, BatchContainer>& containers,
+                       std::vector<BatchJob>& jobs, size_t& skipped) {
+  std::ifstream in(path);
+  if (!in.is_open()) {
+    Log.report(logvisor::Error, FMT_STRING("unable to open manifest {}"), path);
+    return false;
+  }
+
+  std::set<std::string> pathsOut;
+  std::string line;
+  while (std::getline(in, line)) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream fields(line);
+    std::string groupPath, songsPath = "-", songGlob = "*";
+    int setupOverride = -1;
+    if (!(fields >> groupPath))
+      continue;
+    fields >> songsPath >> songGlob >> setupOverride;
+
+    auto containerSearch = containers.find(groupPath);
+    if (containerSearch == containers.end()) {
+      BatchContainer container;
+      container.m_data = amuse::ContainerRegistry::LoadContainer(groupPath.c_str());
+      if (container.m_data.empty()) {
+        Log.report(logvisor::Error, FMT_STRING("invalid/no data at {}"), groupPath);
+        ++skipped;
+        continue;
+      }
+      for (auto& grp : container.m_data)
+        container.m_projs.push_back(amuse::AudioGroupProject::CreateAudioGroupProject(grp.second));
+      container.m_songs =
+          amuse::ContainerRegistry::LoadSongs(songsPath == "-" ? groupPath.c_str() : songsPath.c_str());
+      containerSearch = containers.emplace(groupPath, std::move(container)).first;
+    }
+    BatchContainer& container = containerSearch->second;
+
+    for (auto& [songName, songData] : container.m_songs) {
+      if (!GlobMatch(songGlob.c_str(), songName.c_str()))
+        continue;
+      const int setupId = setupOverride != -1 ? setupOverride : songData.m_setupId;
+
+      /* Locate song group owning this setup (and the group data it lives in) */
+      BatchJob job{nullptr, songData.m_data.get(), {}, songName, songData.m_groupId, setupId, {}};
+      auto projIt = container.m_projs.begin();
+      for (auto& grp : container.m_data) {
+        for (const auto& [groupId, songGroup] : (projIt++)->songGroups()) {
+          if ((job.m_groupId == -1 || groupId.id == job.m_groupId) && songGroup->m_midiSetups.count(setupId)) {
+            job.m_data = &grp.second;
+            job.m_groupName = grp.first;
+            job.m_groupId = groupId.id;
+            break;
+          }
+        }
+        if (job.m_data)
+          break;
+      }
+      if (!job.m_data) {
+        Log.report(logvisor::Error, FMT_STRING("unable to find song group for {} setup {}"), songName, setupId);
+        ++skipped;
+        continue;
+      }
+      job.m_pathOut = fmt::format(FMT_STRING("{}-{}-{}.wav"), job.m_groupName, job.m_songName, job.m_setupId);
+      if (!pathsOut.insert(job.m_pathOut).second) {
+        Log.report(logvisor::Error, FMT_STRING("duplicate manifest entry for {}"), job.m_pathOut);
+        ++skipped;
+        continue;
+      }
+      jobs.push_back(std::move(job));
+    }
+  }
+  return true;
+}
+
+int RunBatch(const std::string& manifestPath, unsigned threads, double rate, int chCount, double volume) {
+  std::map<std::string, BatchContainer> containers;
+  std::vector<BatchJob> jobs;
+  size_t skipped = 0;
+  if (!LoadBatchManifest(manifestPath, containers, jobs, skipped))
+    return 1;
+  if (jobs.empty()) {
+    Log.report(logvisor::Error, FMT_STRING("no jobs in manifest {}"), manifestPath);
+    return 1;
+  }
+
+  const amuse::AudioChannelSet chSet = ChannelSetForCount(chCount);
+  std::atomic_size_t nextJob = 0;
+  std::atomic_size_t failures = 0;
+  std::mutex printLock;
+
+  auto worker = [&]() {
+    for (size_t i = nextJob++; i < jobs.size() && !g_BreakLoop; i = nextJob++) {
+      const BatchJob& job = jobs[i];
+      const auto start = std::chrono::steady_clock::now();
+
+      const std::string& pathOut = job.m_pathOut;
+      amuse::OfflineBackendVoiceAllocator backend(rate, chSet);
+      amuse::Engine engine(backend, amuse::AmplitudeMode::PerSample);
+      engine.setVolume(float(std::clamp(volume, 0.0, 1.0)));
+      WAVWriter wav(pathOut, uint32_t(rate), uint16_t(backend.getChannelCount()));
+      amuse::ObjToken<amuse::Sequencer> seq;
+      if (wav && engine.addAudioGroup(*job.m_data))
+        seq = engine.seqPlay(job.m_groupId, job.m_setupId, job.m_arrData, false);
+      if (!seq) {
+        ++failures;
+        std::unique_lock lk(printLock);
+        Log.report(logvisor::Error, FMT_STRING("unable to render {}"), pathOut);
+        continue;
+      }
+
+      /* Render in 5ms blocks until the song and its release tails finish */
+      const size_t blockFrames = size_t(rate * 5.0 / 1000.0);
+      std::vector<float> buf(blockFrames * backend.getChannelCount());
+      size_t wroteFrames = 0;
+      do {
+        backend.pumpAndMix(buf.data(), blockFrames);
+        wav.write(buf.data(), buf.size());
+        wroteFrames += blockFrames;
+      } while (!g_BreakLoop && (seq->state() == amuse::SequencerState::Playing || seq->getVoiceCount() != 0));
+
+      const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      const double audio = wroteFrames / rate;
+      std::unique_lock lk(printLock);
+      fmt::print(FMT_STRING("{}: {:.2f}s audio in {:.2f}s wall ({:.1f}x realtime)\n"), pathOut, audio, wall,
+                 wall > 0.0 ? audio / wall : 0.0);
+    }
+  };
+
+  signal(SIGINT, SIGINTHandler);
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  threads = std::clamp(threads, 1u, unsigned(jobs.size()));
+  for (unsigned i = 1; i < threads; ++i)
+    workers.emplace_back(worker);
+  worker();
+  for (std::thread& thread : workers)
+    thread.join();
+
+  const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  fmt::print(FMT_STRING("Rendered {} of {} jobs on {} threads in {:.2f}s\n"), jobs.size() - failures,
+             jobs.size() + skipped, threads, wall);
+  return (failures || skipped) ? 1 : 0;
+}
+
+} // anonymous namespace
+
 int main(int argc, char** argv) {
   logvisor::RegisterConsoleLogger();
 
@@ -77,6 +324,8 @@ int main(int argc, char** argv) {
   double rate = NativeSampleRate;
   int chCount = 2;
   double volume = 1.0;
+  std::string batchManifest;
+  unsigned batchThreads = std::max(std::thread::hardware_concurrency(), 1u);
   for (int i = 1; i < argc; ++i) {
     if (!strncmp(argv[i], "-r", 2)) {
       if (argv[i][2])
@@ -99,14 +348,33 @@ int main(int argc, char** argv) {
         volume = strtod(argv[i + 1], nullptr);
         ++i;
       }
+    } else if (!strncmp(argv[i], "-b", 2)) {
+      if (argv[i][2])
+        batchManifest = &argv[i][2];
+      else if (argc > (i + 1)) {
+        batchManifest = argv[i + 1];
+        ++i;
+      }
+    } else if (!strncmp(argv[i], "-j", 2)) {
+      if (argv[i][2])
+        batchThreads = strtoul(&argv[i][2], nullptr, 0);
+      else if (argc > (i + 1)) {
+        batchThreads = strtoul(argv[i + 1], nullptr, 0);
+        ++i;
+      }
     } else
       m_args.push_back(argv[i]);
   }
 
+  if (!batchManifest.empty())
+    return RunBatch(batchManifest, batchThreads, rate, chCount, volume);
+
   /* Load data */
   if (m_args.size() < 1) {
     Log.report(logvisor::Error,
                FMT_STRING("Usage: amuserender <group-file> [<songs-file>] [-r <sample-rate>] [-c <channel-count>] [-v <volume "
+                   "0.0-1.0>]\n"
+                   "       amuserender -b <manifest> [-j <threads>] [-r <sample-rate>] [-c <channel-count>] [-v <volume "
                    "0.0-1.0>]"));
     return 1;
   }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_set>
 
@@ -7,6 +8,7 @@
 #include "amuse/AudioGroupProject.hpp"
 #include "amuse/AudioGroupSampleDirectory.hpp"
 #include "amuse/Common.hpp"
+#include "amuse/SampleFileWatcher.hpp"
 
 namespace amuse {
 class AudioGroupData;
@@ -22,8 +24,11 @@ protected:
   AudioGroupSampleDirectory m_sdir;
   const unsigned char* m_samp = nullptr;
   std::string m_groupPath; /* Typically only set by editor */
+  std::unique_ptr<SampleFileWatcher> m_sampleWatcher; /* Flags loose sample edits within m_groupPath */
   bool m_valid;
 
+  void _watchSampleFiles();
+
 public:
   std::string getSampleBasePath(SampleId sfxId) const;
   explicit operator bool() const { return m_valid; }
@@ -72,6 +77,9 @@ public:
   void deleteSample(SampleId id);
   void copySampleInto(const std::string& basePath, const std::string& newBasePath);
 
+  /** Add loose sample files that appeared in the group directory and watch them for edits */
+  void reloadSampleData();
+
   void importCHeader(std::string_view header);
   std::string exportCHeader(std::string_view projectName, std::string_view groupName) const;
 };
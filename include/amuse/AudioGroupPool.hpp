@@ -85,14 +85,14 @@ struct SoundMacro {
     SendMessage,
     GetMessage,
     GetVid,
-    AddAgeCount = 0x30, /* unimplemented */
-    SetAgeCount,        /* unimplemented */
-    SendFlag,           /* unimplemented */
+    AddAgeCount = 0x30,
+    SetAgeCount,
+    SendFlag, /* unimplemented */
     PitchWheelR,
-    SetPriority = 0x36, /* unimplemented */
-    AddPriority,        /* unimplemented */
-    AgeCntSpeed,        /* unimplemented */
-    AgeCntVel,          /* unimplemented */
+    SetPriority = 0x36,
+    AddPriority,
+    AgeCntSpeed,
+    AgeCntVel,
     VolSelect = 0x40,
     PanSelect,
     PitchWheelSelect,
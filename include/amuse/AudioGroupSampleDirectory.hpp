@@ -1,10 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <unordered_map>
 #include <vector>
 
 #include "amuse/Common.hpp"
+#include "amuse/N64MusyXCodec.hpp"
 
 #include <athena/DNA.hpp>
 
@@ -209,6 +211,17 @@ public:
     /* Stored out-of-band in a platform-dependent way */
     ADPCMParms m_ADPCMParms;
 
+    /* Expanded form of m_ADPCMParms.vadpcm for the vectorized N64 decoder */
+    std::unique_ptr<N64MusyXPredictor> m_vadpcmPredictor;
+
+    /* DSPADPCM predictor history captured every DSPSeekInterval frames */
+    struct DSPSeekPoint {
+      int16_t m_hist1;
+      int16_t m_hist2;
+    };
+    static constexpr uint32_t DSPSeekInterval = 32;
+    std::vector<DSPSeekPoint> m_dspSeekIndex;
+
     /* In-memory storage of an individual sample. Editors use this structure
      * to override the loaded sample with a file-backed version without repacking
      * the sample data into a SAMP block. */
@@ -285,6 +298,15 @@ public:
       return ret;
     }
 
+    /** Rebuild m_dspSeekIndex by decoding predictor state across `data` */
+    void buildDSPSeekIndex(const unsigned char* data);
+
+    /** Resolve DSPADPCM predictor history at `sample` using the seek index (if built) */
+    void seekDSPState(const unsigned char* data, uint32_t sample, int16_t* prev1, int16_t* prev2) const;
+
+    /** Rebuild m_vadpcmPredictor after loading VADPCM codebook */
+    void buildVADPCMPredictor() { m_vadpcmPredictor = std::make_unique<N64MusyXPredictor>(m_ADPCMParms.vadpcm.m_coefs); }
+
     void loadLooseDSP(std::string_view dspPath);
     void loadLooseVADPCM(std::string_view vadpcmPath);
     void loadLooseWAV(std::string_view wavPath);
@@ -299,6 +321,10 @@ public:
   struct Entry {
     ObjToken<EntryData> m_data;
 
+    /* Set when loose files may have changed since m_data was loaded; entries start dirty
+     * until a SampleFileWatcher takes over reporting changes */
+    std::atomic_bool m_looseDirty = {true};
+
     Entry() : m_data(MakeObj<EntryData>()) {}
 
     template <athena::Endian DNAE>
@@ -3,7 +3,6 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
-#include <list>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -12,6 +11,7 @@
 #include "amuse/IBackendVoice.hpp"
 #include "amuse/IBackendSubmix.hpp"
 #include "amuse/IBackendVoiceAllocator.hpp"
+#include "amuse/MIDIEventQueue.hpp"
 
 #include <boo/audiodev/IAudioSubmix.hpp>
 #include <boo/audiodev/IAudioVoiceEngine.hpp>
@@ -23,7 +23,9 @@ namespace amuse {
 /** Backend voice implementation for boo mixer */
 class BooBackendVoice : public IBackendVoice {
   friend class BooBackendVoiceAllocator;
-  Voice& m_clientVox;
+  Voice* m_clientVox; /**< Null while parked in a voice pool slot */
+  double m_sampleRate;
+  bool m_dynamicPitch;
   struct VoiceCallback : boo::IAudioVoiceCallback {
     BooBackendVoice& m_parent;
     void preSupplyAudio(boo::IAudioVoice& voice, double dt) override;
@@ -81,9 +83,10 @@ protected:
   std::unique_ptr<boo::IMIDIIn> m_virtualIn;
   boo::MIDIDecoder m_decoder;
 
-  bool m_useLock;
-  std::list<std::pair<double, std::vector<uint8_t>>> m_queue;
-  std::mutex m_midiMutex;
+  bool m_useLock;                 /**< Serialize producers when inputs may call back on several threads */
+  std::mutex m_midiMutex;         /**< Taken by producers only, never by pumpReader */
+  MIDIEventQueue m_queue;
+  std::vector<uint8_t> m_pumpBuf; /**< Preallocated for the decoder; pumpReader never grows it */
   void _MIDIReceive(std::vector<uint8_t>&& bytes, double time);
 
 public:
@@ -137,6 +140,8 @@ protected:
 public:
   BooBackendVoiceAllocator(boo::IAudioVoiceEngine& booEngine);
   std::unique_ptr<IBackendVoice> allocateVoice(Voice& clientVox, double sampleRate, bool dynamicPitch) override;
+  bool releaseVoice(IBackendVoice& voice) override;
+  bool reuseVoice(IBackendVoice& voice, Voice& clientVox, double sampleRate, bool dynamicPitch) override;
   std::unique_ptr<IBackendSubmix> allocateSubmix(Submix& clientSmx, bool mainOut, int busId) override;
   std::vector<std::pair<std::string, std::string>> enumerateMIDIDevices() override;
   std::unique_ptr<IMIDIReader> allocateMIDIReader(Engine& engine) override;
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "amuse/Common.hpp"
+#include "amuse/Entity.hpp"
+#include "amuse/Studio.hpp"
+
+namespace amuse {
+class Engine;
+class Sequencer;
+class Voice;
+
+enum class FutureState { Pending, Ready, Failed };
+
+/** Handle to an entity created by a queued command.
+ *  Resolves on the mixing thread when the command runs; other threads poll state() and never block.
+ *  Commands queued after the one that created it may target it while it is still pending.
+ *  The future only holds a weak handle; the entity is reached through CommandQueue::resolve() on the
+ *  mixing thread, so dropping a future never keeps an entity alive or destroys one off that thread.
+ *  The handle is recycled once the entity is destroyed or the last outside reference to the future drops. */
+template <class T>
+class EntityFuture : public IObj {
+  friend class CommandQueue;
+  std::atomic<FutureState> m_state = {FutureState::Pending};
+  uint32_t m_handle = 0;     /**< Slot in the queue's handle table; written before m_state is published */
+  uint32_t m_generation = 0; /**< Generation of that slot when the future resolved */
+
+public:
+  FutureState state() const { return m_state.load(std::memory_order_acquire); }
+  bool isPending() const { return state() == FutureState::Pending; }
+};
+
+using VoiceFuture = EntityFuture<Voice>;
+using SequencerFuture = EntityFuture<Sequencer>;
+
+/** Bounded lock-free queue of commands posted by any number of threads and run by the Engine
+ *  at the start of each 5ms interval, in posting order.
+ *  Posting never blocks; it fails (returns false or a null future) when the queue is full.
+ *  post() does not allocate; postFuture() (and so fxStart/seqPlay) heap-allocates the returned future. */
+class CommandQueue {
+public:
+  static constexpr size_t CommandStorage = 64;
+  static constexpr size_t DefaultCapacity = 256;
+
+private:
+  using CommandOp = void (*)(void* storage, Engine* engine); /**< Runs (engine non-null) then destroys */
+
+  struct Slot {
+    std::atomic<size_t> m_seq;
+    CommandOp m_op = nullptr;
+    alignas(std::max_align_t) unsigned char m_storage[CommandStorage];
+  };
+
+  /** Strong references backing a resolved future; touched only on the mixing thread */
+  struct HandleSlot {
+    ObjToken<Entity> m_entity;
+    ObjToken<IObj> m_future; /**< Lets the mixing thread see when it holds the future's last reference */
+    uint32_t m_generation = 0;
+  };
+
+  std::unique_ptr<Slot[]> m_slots;
+  size_t m_mask;
+  alignas(64) std::atomic<size_t> m_enqueuePos = {0};
+  alignas(64) size_t m_dequeuePos = 0;
+  std::unique_ptr<HandleSlot[]> m_handles; /**< One per command slot */
+
+  Slot* _claimSlot();
+  HandleSlot* _freeHandle();
+  Entity* _lookupHandle(uint32_t handle, uint32_t generation) const;
+  void _releaseHandles();
+
+  /** A handle is reserved before the entity is created, so a future never fails for an entity that plays */
+  template <class T, class Func>
+  void _resolve(EntityFuture<T>& future, Func& func, Engine& engine) {
+    HandleSlot* handle = _freeHandle();
+    ObjToken<T> obj = handle ? func(engine) : ObjToken<T>{};
+    if (obj) {
+      handle->m_entity = static_cast<IObj*>(obj.get());
+      handle->m_future = static_cast<IObj*>(&future);
+      future.m_handle = uint32_t(handle - m_handles.get());
+      future.m_generation = handle->m_generation;
+    }
+    future.m_state.store(obj ? FutureState::Ready : FutureState::Failed, std::memory_order_release);
+  }
+
+  template <class Func>
+  static void _runCommand(void* storage, Engine* engine) {
+    Func& func = *static_cast<Func*>(storage);
+    if (engine)
+      func(*engine);
+    func.~Func();
+  }
+
+public:
+  explicit CommandQueue(size_t capacity = DefaultCapacity);
+  ~CommandQueue();
+
+  CommandQueue(const CommandQueue&) = delete;
+  CommandQueue& operator=(const CommandQueue&) = delete;
+
+  /** Queue `func(Engine&)` to run on the mixing thread; returns false when the queue is full */
+  template <class Func>
+  bool post(Func&& func) {
+    using FuncType = std::decay_t<Func>;
+    static_assert(sizeof(FuncType) <= CommandStorage, "command capture exceeds CommandStorage");
+    static_assert(alignof(FuncType) <= alignof(std::max_align_t), "command capture is over-aligned");
+    Slot* slot = _claimSlot();
+    if (!slot)
+      return false;
+    new (slot->m_storage) FuncType(std::forward<Func>(func));
+    slot->m_op = &_runCommand<FuncType>;
+    slot->m_seq.store(slot->m_seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** Queue `func(Engine&) -> ObjToken<T>`, returning a future that resolves to its result.
+   *  Failed means nothing was created: `func` returned null, or it was not run because every handle
+   *  is bound to a live entity whose future is still referenced */
+  template <class T, class Func>
+  ObjToken<EntityFuture<T>> postFuture(Func&& func) {
+    ObjToken<EntityFuture<T>> future = MakeObj<EntityFuture<T>>();
+    if (!post([this, future, func = std::forward<Func>(func)](Engine& engine) mutable {
+          _resolve(*future, func, engine);
+        }))
+      return {};
+    return future;
+  }
+
+  /** Entity a future resolved to, or null while pending, after failure or once the entity is destroyed.
+   *  Mixing thread only (i.e. from within a queued command) */
+  template <class T>
+  T* resolve(const ObjToken<EntityFuture<T>>& future) const {
+    if (!future || future->state() != FutureState::Ready)
+      return nullptr;
+    return static_cast<T*>(_lookupHandle(future->m_handle, future->m_generation));
+  }
+
+  /** Queued Engine::fxStart; a null studio selects the engine's default studio */
+  ObjToken<VoiceFuture> fxStart(SFXId sfxId, float vol, float pan, ObjToken<Studio> smx = {});
+
+  /** Queued Engine::seqPlay; a null studio selects the engine's default studio */
+  ObjToken<SequencerFuture> seqPlay(GroupId groupId, SongId songId, const unsigned char* arrData, bool loop = true,
+                                    ObjToken<Studio> smx = {});
+
+  /** Queued Engine::setVolume */
+  bool setVolume(float vol);
+
+  /** Queued Voice::keyOff; ignored if the voice failed to start */
+  bool keyOff(ObjToken<VoiceFuture> voice);
+
+  /** Queued Sequencer::stopSong; ignored if the sequencer failed to start */
+  bool stopSong(ObjToken<SequencerFuture> seq, float fadeTime = 0.f, bool now = false);
+
+  /** Run queued commands in posting order; called by the Engine on the mixing thread */
+  void drain(Engine& engine);
+};
+
+} // namespace amuse
@@ -153,6 +153,8 @@ public:
       delete this;
     }
   }
+  /** Live references; a count of 1 observed by the only holder cannot change underneath it */
+  int refCount() const noexcept { return m_refCount.load(std::memory_order_acquire); }
 };
 
 template <class SubCls>
@@ -26,6 +26,16 @@ unsigned DSPDecompressFrameStateOnly(const uint8_t* in, const int16_t coefs[8][2
 unsigned DSPDecompressFrameRangedStateOnly(const uint8_t* in, const int16_t coefs[8][2], int16_t* prev1, int16_t* prev2,
                                            unsigned firstSample, unsigned lastSample);
 
+/** Decode `lastSample` samples from contiguous frames starting at `in`.
+ *  Selects the fastest implementation for the host CPU at first use */
+unsigned DSPDecompressFrames(int16_t* out, const uint8_t* in, const int16_t coefs[8][2], int16_t* prev1,
+                             int16_t* prev2, unsigned lastSample);
+
+/** Same as DSPDecompressFrames, beginning at `firstSample` of the first frame.
+ *  `lastSample` is relative to the start of the first frame and may span many frames */
+unsigned DSPDecompressFramesRanged(int16_t* out, const uint8_t* in, const int16_t coefs[8][2], int16_t* prev1,
+                                   int16_t* prev2, unsigned firstSample, unsigned lastSample);
+
 void DSPCorrelateCoefs(const short* source, int samples, short coefsOut[8][2]);
 
 void DSPEncodeFrame(short pcmInOut[16], int sampleCount, unsigned char adpcmOut[8], const short coefsIn[8][2]);
@@ -1,20 +1,44 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
 namespace amuse {
 struct ChannelMap;
 
-enum class EffectType { Invalid, ReverbStd, ReverbHi, Delay, Chorus, EffectTypeMAX };
+enum class EffectType { Invalid, ReverbStd, ReverbHi, Delay, Chorus, Convolution, EffectTypeMAX };
 
 class EffectBaseTypeless {
 public:
   virtual ~EffectBaseTypeless() = default;
   virtual void resetOutputSampleRate(double sampleRate) = 0;
   virtual EffectType Isa() const = 0;
+
+  /** Seconds the effect keeps producing output after its input falls silent;
+   *  infinity if it may never decay (e.g. full feedback) */
+  virtual double getTailTime() const = 0;
 };
 
 template <typename T>
 class EffectBase : public EffectBaseTypeless {
 public:
   virtual void applyEffect(T* audio, size_t frameCount, const ChannelMap& chanMap) = 0;
+
+  /** Mean-square level of `sampleCount` samples, normalized to full scale */
+  static float Energy(const T* audio, size_t sampleCount) {
+    if (!sampleCount)
+      return 0.f;
+    float sum = 0.f;
+    for (size_t i = 0; i < sampleCount; ++i)
+      sum += float(audio[i]) * float(audio[i]);
+    if constexpr (std::is_floating_point_v<T>) {
+      return sum / float(sampleCount);
+    } else {
+      constexpr float FullScale = -float(std::numeric_limits<T>::min());
+      return sum / (FullScale * FullScale) / float(sampleCount);
+    }
+  }
 };
 } // namespace amuse
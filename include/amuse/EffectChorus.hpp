@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdint>
+#include <memory>
 
 #include "amuse/Common.hpp"
 #include "amuse/EffectBase.hpp"
@@ -70,11 +71,14 @@ public:
 /** Type-specific implementation of chorus effect */
 template <typename T>
 class EffectChorusImp : public EffectBase<T>, public EffectChorus {
-  /** Evenly-allocated pointer-table for each channel's delay */
-  std::array<std::array<T*, AMUSE_CHORUS_NUM_BLOCKS>, NumChannels> x0_lastChans{};
+  /** Last 3 samples read by the resampler, one row of NumChannels lanes per sample */
+  using History = std::array<std::array<float, NumChannels>, 3>;
+
+  /** Delay buffer of AMUSE_CHORUS_NUM_BLOCKS blocks; each sample is a row of NumChannels lanes */
+  std::unique_ptr<float[]> x0_lastChans;
 
   uint8_t x24_currentLast = 1; /**< Last 5ms block-idx to be processed */
-  std::array<std::array<T, 4>, NumChannels> x28_oldChans{}; /**< Unprocessed history of previous 4 samples */
+  History x28_oldChans{};      /**< Unprocessed history of previous samples */
 
   uint32_t x58_currentPosLo = 0; /**< 16.7 fixed-point low-part of sample index */
   uint32_t x5c_currentPosHi = 0; /**< 16.7 fixed-point high-part of sample index */
@@ -83,30 +87,45 @@ class EffectChorusImp : public EffectBase<T>, public EffectChorus {
   uint32_t x64_pitchOffsetPeriodCount; /**< trigger value for flipping SRC state */
   uint32_t x68_pitchOffsetPeriod;      /**< intermediate block window quantity for calculating SRC state */
 
+  /** Resampler state shared by all channels; each output sample interpolates every lane at once */
   struct SrcInfo {
-    T* x6c_dest;             /**< selected channel's live buffer */
-    T* x70_smpBase;          /**< selected channel's delay buffer */
-    T* x74_old;              /**< selected channel's 4-sample history buffer */
-    uint32_t x78_posLo;      /**< 16.7 fixed-point low-part of sample index */
-    uint32_t x7c_posHi;      /**< 16.7 fixed-point high-part of sample index */
-    uint32_t x80_pitchLo;    /**< 16.7 fixed-point low-part of sample-rate conversion differential */
-    uint32_t x84_pitchHi;    /**< 16.7 fixed-point low-part of sample-rate conversion differential */
-    uint32_t x88_trigger;    /**< total count of samples per channel across all blocks */
-    uint32_t x8c_target = 0; /**< value to reset to when trigger hit */
-
+    T* x6c_dest;              /**< interleaved live buffer */
+    const float* x70_smpBase; /**< lane rows of the delay buffer */
+    History* x74_old;         /**< lane rows of the history */
+    uint32_t x78_posLo;       /**< 16.7 fixed-point low-part of sample index */
+    uint32_t x7c_posHi;       /**< 16.7 fixed-point high-part of sample index */
+    uint32_t x80_pitchLo;     /**< 16.7 fixed-point low-part of sample-rate conversion differential */
+    uint32_t x84_pitchHi;     /**< 16.7 fixed-point low-part of sample-rate conversion differential */
+    uint32_t x88_trigger;     /**< total count of samples per channel across all blocks */
+    uint32_t x8c_target = 0;  /**< value to reset to when trigger hit */
+
+    template <size_t Groups>
     void doSrc1(size_t blockSamples, size_t chanCount);
+    template <size_t Groups>
     void doSrc2(size_t blockSamples, size_t chanCount);
   };
   SrcInfo x6c_src;
 
+  /** Modulation state replaced by the last _update; its output fades out over the next block */
+  struct FadeState {
+    uint32_t m_posLo = 0;
+    uint32_t m_posHi = 0;
+    int32_t m_pitchOffset = 0;
+    bool m_pending = false;
+  };
+  FadeState m_fadeFrom;
+  bool m_primed = false;          /**< a block has been processed since the last _setup */
+  std::unique_ptr<T[]> m_fadeBuf; /**< interleaved output of the outgoing state during a fade */
+
   uint32_t m_sampsPerMs;   /**< canonical count of samples per ms for the current backend */
   uint32_t m_blockSamples; /**< count of samples in a 5ms block */
 
   void _setup(double sampleRate);
   void _update();
+  void _render(T* out, size_t frames, unsigned chanCount, int32_t pitchOffset, uint32_t& posHi, uint32_t& posLo,
+               History& history);
 
 public:
-  ~EffectChorusImp() override;
   EffectChorusImp(uint32_t baseDelay, uint32_t variation, uint32_t period, double sampleRate);
   EffectChorusImp(const EffectChorusInfo& info, double sampleRate)
   : EffectChorusImp(info.baseDelay, info.variation, info.period, sampleRate) {}
@@ -115,5 +134,6 @@ public:
   void resetOutputSampleRate(double sampleRate) override { _setup(sampleRate); }
 
   EffectType Isa() const override { return EffectType::Chorus; }
+  double getTailTime() const override { return AMUSE_CHORUS_NUM_BLOCKS * 0.005; }
 };
 } // namespace amuse
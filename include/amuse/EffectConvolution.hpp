@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "amuse/Common.hpp"
+#include "amuse/EffectBase.hpp"
+#include "amuse/IBackendVoice.hpp"
+
+namespace amuse {
+template <typename T>
+class EffectConvolutionImp;
+struct ConvolutionKernel;
+
+/** Progress of the impulse response most recently given to EffectConvolution */
+enum class ConvolutionIRState {
+  None,      /**< No IR given yet; audio passes through unchanged */
+  Preparing, /**< Loading, resampling and transforming on a background thread */
+  Ready,     /**< Handed to the audio thread; takes over within one block */
+  Failed     /**< Unreadable or empty; the previous IR (if any) stays in use */
+};
+
+/** Parameters needed to create EffectConvolution */
+struct EffectConvolutionInfo {
+  std::string irPath; /**< WAV file of the impulse response; empty to start without one */
+  float mix = 0.5f;   /**< [0.0, 1.0] wet/dry mix factor */
+
+  EffectConvolutionInfo() = default;
+  EffectConvolutionInfo(std::string_view irPathIn, float mixIn) : irPath(irPathIn), mix(mixIn) {}
+};
+
+/** Convolves the audio with a sampled impulse response (e.g. a recorded room).
+ *  The IR is split into partitions that grow from BasePartition to MaxPartition samples, each run of
+ *  equal partitions convolved by FFT against a history of input spectra: the short head keeps the wet
+ *  latency at BasePartition samples while the long tail partitions keep long IRs cheap. Each large
+ *  partition's transforms are spread across the BasePartition steps before its output is due, so the cost
+ *  per block stays near the average. IRs are prepared on a background thread and cross-faded in over one block. */
+class EffectConvolution {
+public:
+  static constexpr uint32_t BasePartition = 128; /**< Head partition in samples; also the latency of the wet signal */
+  static constexpr uint32_t MaxPartition = 4096; /**< Partition size the tail grows to */
+  static constexpr float MaxIRTime = 10.f;       /**< Seconds of IR used; longer files are truncated */
+
+protected:
+  static constexpr size_t ChunkFrames = 256; /**< Frames processed per pass through the float scratch buffers */
+
+  float m_mix;              /**< [0.0, 1.0] wet/dry mix factor */
+  float m_appliedMix = 0.f; /**< mix reached by the previous block; 0 until an IR is running */
+  double m_tailTime = 0.0;  /**< length of the running IR in seconds, for the audio thread */
+
+  std::unique_ptr<float[]> m_wetBuf;  /**< wet output of the running IR for one chunk */
+  std::unique_ptr<float[]> m_fadeBuf; /**< wet output of the IR being replaced for one chunk */
+
+  std::string m_irPath; /**< file of the most recent loadIR */
+
+  /* Requests to the preparation thread. The audio thread only ever touches the atomics, so an output
+   * rate change costs it a store and a wake-up; the IR is re-prepared at the new rate in the background. */
+  std::mutex m_prepLock;            /**< guards the m_req fields and m_quit */
+  std::condition_variable m_prepCv; /**< wakes the preparation thread */
+  std::string m_reqPath;            /**< file to load next; empty when m_reqSamples holds the IR */
+  std::vector<float> m_reqSamples;  /**< interleaved IR given to setIR */
+  unsigned m_reqChannels = 0;
+  double m_reqRate = 0.0;
+  bool m_reqSource = false; /**< a new source IR awaits the preparation thread */
+  bool m_quit = false;
+  std::atomic<uint32_t> m_prepGen = {0}; /**< bumped by every request, including output rate changes */
+  std::atomic<double> m_sampleRate;      /**< output rate IRs are prepared for */
+  std::thread m_prepThread;              /**< started by the first loadIR/setIR, runs until destruction */
+
+  /* Source IR as last loaded; preparation thread only */
+  std::vector<float> m_irSamples; /**< interleaved source IR at m_irRate, kept for re-preparation */
+  unsigned m_irChannels = 0;
+  double m_irRate = 0.0;
+
+  std::atomic<ConvolutionIRState> m_irState = {ConvolutionIRState::None};
+
+  std::unique_ptr<ConvolutionKernel> m_active;           /**< IR in use; audio thread only */
+  std::atomic<ConvolutionKernel*> m_pending = {nullptr}; /**< newly prepared IR awaiting the audio thread */
+  std::atomic<ConvolutionKernel*> m_retired = {nullptr}; /**< replaced IRs, freed by the preparation thread */
+
+  void _wakePrepare();
+  void _prepareThread();
+  ConvolutionIRState _prepare(bool newSource, const std::string& path);
+  void _freeRetired();
+  void _resetSampleRate(double sampleRate);
+  void _process(float* audio, size_t frameCount, unsigned chanCount);
+
+public:
+  template <typename T>
+  using ImpType = EffectConvolutionImp<T>;
+
+  EffectConvolution(float mix, double sampleRate);
+  ~EffectConvolution();
+  EffectConvolution(const EffectConvolution&) = delete;
+  EffectConvolution& operator=(const EffectConvolution&) = delete;
+
+  void setMix(float mix) { m_mix = std::clamp(mix, 0.f, 1.f); }
+  float getMix() const { return m_mix; }
+
+  /** Load the IR from a WAV file (PCM 16/24/32-bit or 32-bit float, any channel count) in the background.
+   *  Output channel c convolves with IR channel c modulo the IR's channel count. */
+  void loadIR(std::string_view path);
+
+  /** Use `frameCount` frames of interleaved samples at `sampleRate` as the IR, prepared in the background */
+  void setIR(const float* samples, size_t frameCount, unsigned channels, double sampleRate);
+
+  /** Path given to the most recent loadIR */
+  const std::string& getIRPath() const { return m_irPath; }
+
+  /** Readable from any thread */
+  ConvolutionIRState getIRState() const { return m_irState.load(std::memory_order_acquire); }
+
+  void setParams(const EffectConvolutionInfo& info) {
+    setMix(info.mix);
+    if (!info.irPath.empty())
+      loadIR(info.irPath);
+  }
+};
+
+/** Type-specific implementation of convolution effect */
+template <typename T>
+class EffectConvolutionImp : public EffectBase<T>, public EffectConvolution {
+  std::unique_ptr<float[]> m_ioBuf; /**< float copy of a chunk of integer audio */
+
+public:
+  EffectConvolutionImp(float mix, double sampleRate);
+  EffectConvolutionImp(std::string_view irPath, float mix, double sampleRate);
+  EffectConvolutionImp(const EffectConvolutionInfo& info, double sampleRate);
+
+  void applyEffect(T* audio, size_t frameCount, const ChannelMap& chanMap) override;
+  void resetOutputSampleRate(double sampleRate) override { _resetSampleRate(sampleRate); }
+
+  EffectType Isa() const override { return EffectType::Convolution; }
+  double getTailTime() const override { return m_tailTime; }
+};
+} // namespace amuse
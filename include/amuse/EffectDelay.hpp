@@ -104,12 +104,18 @@ public:
 /** Type-specific implementation of delay effect */
 template <typename T>
 class EffectDelayImp : public EffectBase<T>, public EffectDelay {
-  std::array<uint32_t, NumChannels> x0_currentSize;      /**< per-channel delay-line buffer sizes */
-  std::array<uint32_t, NumChannels> xc_currentPos;       /**< per-channel block-index */
+  std::array<uint32_t, NumChannels> x0_currentSize;      /**< per-channel delay in blocks */
   std::array<uint32_t, NumChannels> x18_currentFeedback; /**< [0, 128] feedback attenuator */
   std::array<uint32_t, NumChannels> x24_currentOutput;   /**< [0, 128] total attenuator */
 
-  std::array<std::unique_ptr<T[]>, NumChannels> x30_chanLines; /**< delay-line buffers for each channel */
+  /** Values applied by the previous block; changes cross-fade the delay tap and ramp the gains from these */
+  std::array<uint32_t, NumChannels> m_prevSize{};
+  std::array<uint32_t, NumChannels> m_prevFeedback{};
+  std::array<uint32_t, NumChannels> m_prevOutput{};
+
+  std::array<std::unique_ptr<T[]>, NumChannels> x30_chanLines; /**< delay-line buffers sized for the max delay */
+  uint32_t m_lineSize = 0;                                      /**< sample count of each delay line */
+  uint32_t m_linePos = 0;                                       /**< shared write position of all delay lines */
 
   uint32_t m_sampsPerMs;   /**< canonical count of samples per ms for the current backend */
   uint32_t m_blockSamples; /**< count of samples in a 5ms block */
@@ -124,5 +130,6 @@ public:
   void resetOutputSampleRate(double sampleRate) override { _setup(sampleRate); }
 
   EffectType Isa() const override { return EffectType::Delay; }
+  double getTailTime() const override;
 };
 } // namespace amuse
@@ -37,16 +37,28 @@ struct EffectReverbHiInfo {
   : coloration(coloration), mix(mix), time(time), damping(damping), preDelay(preDelay), crosstalk(crosstalk) {}
 };
 
-/** Delay state for one 'tap' of the reverb effect */
+/** Delay state for one 'tap' of the reverb effect, with one lane per channel.
+ *  Lanes share a power-of-two ring and the write position, so all channels advance in SIMD lanes.
+ *  Allocated once per sample rate; the delay may then change freely up to the allocated maximum */
 struct ReverbDelayLine {
-  int32_t x0_inPoint = 0;
-  int32_t x4_outPoint = 0;
-  int32_t x8_length = 0;
-  std::unique_ptr<float[]> xc_inputs;
-  float x10_lastInput = 0.f;
-
-  void allocate(int32_t delay);
-  void setdelay(int32_t delay);
+  std::unique_ptr<float[]> m_buf;                         /**< NumChannels lanes per row */
+  uint32_t m_mask = 0;                                    /**< Row count minus one */
+  uint32_t m_delay = 0;                                   /**< Rows between write and read, up to m_mask */
+  alignas(16) std::array<float, NumChannels> m_lastOut{}; /**< Per-lane output of the previous sample */
+
+  void allocate(uint32_t maxDelay);
+};
+
+/** Reverb coefficients in effect at the end of the last processed block.
+ *  After a parameter change the next block ramps from these to the new values rather than stepping */
+struct ReverbRampState {
+  float m_allPassCoef = 0.f;
+  std::array<float, 3> m_combCoef{};
+  float m_damping = 0.f;
+  float m_level = 0.f;
+  float m_crosstalk = 0.f;
+  uint32_t m_preDelay = 0; /**< Pre-delay line delay; cross-faded rather than ramped */
+  bool m_pending = false;  /**< Parameters changed since the last block */
 };
 
 template <typename T>
@@ -146,24 +158,24 @@ public:
 /** Standard-quality 2-stage reverb */
 template <typename T>
 class EffectReverbStdImp : public EffectBase<T>, public EffectReverbStd {
-  using CombCoeffArray = std::array<std::array<float, 2>, NumChannels>;
-  using ReverbDelayArray = std::array<std::array<ReverbDelayLine, 2>, NumChannels>;
-  using PreDelayArray = std::array<std::unique_ptr<float[]>, NumChannels>;
-
-  ReverbDelayArray x0_AP{};                           /**< All-pass delay lines */
-  ReverbDelayArray x78_C{};                           /**< Comb delay lines */
-  float xf0_allPassCoef = 0.f;                        /**< All-pass mix coefficient */
-  CombCoeffArray xf4_combCoef{};                      /**< Comb mix coefficients */
-  std::array<float, NumChannels> x10c_lpLastout{};    /**< Last low-pass results */
-  float x118_level = 0.f;                             /**< Internal wet/dry mix factor */
-  float x11c_damping = 0.f;                           /**< Low-pass damping */
-  int32_t x120_preDelayTime = 0;                      /**< Sample count of pre-delay */
-  PreDelayArray x124_preDelayLine;                    /**< Dedicated pre-delay buffers */
-  std::array<float*, NumChannels> x130_preDelayPtr{}; /**< Current pre-delay pointers */
+  std::array<ReverbDelayLine, 2> x0_AP;                        /**< All-pass delay lines */
+  std::array<ReverbDelayLine, 2> x78_C;                        /**< Comb delay lines */
+  float xf0_allPassCoef = 0.f;                                 /**< All-pass mix coefficient */
+  std::array<float, 2> xf4_combCoef{};                         /**< Comb mix coefficients (same for all channels) */
+  alignas(16) std::array<float, NumChannels> x10c_lpLastout{}; /**< Last low-pass results */
+  float x118_level = 0.f;                                      /**< Internal wet/dry mix factor */
+  float x11c_damping = 0.f;                                    /**< Low-pass damping */
+  int32_t x120_preDelayTime = 0;                               /**< Sample count of pre-delay */
+  ReverbDelayLine x124_preDelayLine;                           /**< Pre-delay, one lane per channel */
+  uint32_t m_linePos = 0;                                      /**< Shared write position of all delay lines */
+  alignas(16) std::array<float, 160 * NumChannels> m_block;    /**< Current block, deinterleaved to lanes */
+  ReverbRampState m_ramp;                                      /**< Coefficients applied by the last block */
 
   double m_sampleRate; /**< copy of sample rate */
   void _setup(double sampleRate);
   void _update();
+  template <bool Ramp>
+  void _handleReverb(unsigned chanCount, size_t sampleCount);
 
 public:
   EffectReverbStdImp(float coloration, float mix, float time, float damping, float preDelay, double sampleRate);
@@ -174,35 +186,34 @@ public:
   void resetOutputSampleRate(double sampleRate) override { _setup(sampleRate); }
 
   EffectType Isa() const override { return EffectType::ReverbStd; }
+  double getTailTime() const override { return x150_x1d8_preDelay + x148_x1d0_time; }
 };
 
 /** High-quality 3-stage reverb with per-channel low-pass and crosstalk */
 template <typename T>
 class EffectReverbHiImp : public EffectBase<T>, public EffectReverbHi {
-  using AllPassDelayLines = std::array<std::array<ReverbDelayLine, 2>, NumChannels>;
-  using CombCoefficients = std::array<std::array<float, 3>, NumChannels>;
-  using CombDelayLines = std::array<std::array<ReverbDelayLine, 3>, NumChannels>;
-  using LowPassDelayLines = std::array<ReverbDelayLine, 8>;
-  using PreDelayLines = std::array<std::unique_ptr<float[]>, 8>;
-
-  AllPassDelayLines x0_AP{};                          /**< All-pass delay lines */
-  LowPassDelayLines x78_LP{};                         /**< Per-channel low-pass delay-lines */
-  CombDelayLines xb4_C{};                             /**< Comb delay lines */
-  float x168_allPassCoef = 0.f;                       /**< All-pass mix coefficient */
-  CombCoefficients x16c_combCoef{};                   /**< Comb mix coefficients */
-  std::array<float, 8> x190_lpLastout{};              /**< Last low-pass results */
-  float x19c_level = 0.f;                             /**< Internal wet/dry mix factor */
-  float x1a0_damping = 0.f;                           /**< Low-pass damping */
-  int32_t x1a4_preDelayTime = 0;                      /**< Sample count of pre-delay */
-  PreDelayLines x1ac_preDelayLine;                    /**< Dedicated pre-delay buffers */
-  std::array<float*, NumChannels> x1b8_preDelayPtr{}; /**< Current pre-delay pointers */
+  std::array<ReverbDelayLine, 2> x0_AP;                        /**< All-pass delay lines */
+  ReverbDelayLine x78_LP;                                      /**< Per-channel low-pass delay-lines, one per lane */
+  std::array<ReverbDelayLine, 3> xb4_C;                        /**< Comb delay lines */
+  float x168_allPassCoef = 0.f;                                /**< All-pass mix coefficient */
+  std::array<float, 3> x16c_combCoef{};                        /**< Comb mix coefficients (same for all channels) */
+  alignas(16) std::array<float, NumChannels> x190_lpLastout{}; /**< Last low-pass results */
+  float x19c_level = 0.f;                                      /**< Internal wet/dry mix factor */
+  float x1a0_damping = 0.f;                                    /**< Low-pass damping */
+  int32_t x1a4_preDelayTime = 0;                               /**< Sample count of pre-delay */
+  ReverbDelayLine x1ac_preDelayLine;                           /**< Pre-delay, one lane per channel */
   float x1a8_internalCrosstalk = 0.f;
+  std::array<uint32_t, NumChannels> m_lpDelays{};           /**< Per-lane delay of x78_LP */
+  uint32_t m_linePos = 0;                                   /**< Shared write position of all delay lines */
+  alignas(16) std::array<float, 160 * NumChannels> m_block; /**< Current block, deinterleaved to lanes */
+  ReverbRampState m_ramp;                                   /**< Coefficients applied by the last block */
 
   double m_sampleRate; /**< copy of sample rate */
   void _setup(double sampleRate);
   void _update();
-  void _handleReverb(T* audio, int chanIdx, int chanCount, int sampleCount);
-  void _doCrosstalk(T* audio, float wet, float dry, int chanCount, int sampleCount);
+  template <bool Ramp>
+  void _handleReverb(unsigned chanCount, size_t sampleCount);
+  void _doCrosstalk(T* audio, float wetFrom, float wetTo, int chanCount, int sampleCount);
 
 public:
   EffectReverbHiImp(float coloration, float mix, float time, float damping, float preDelay, float crosstalk,
@@ -214,5 +225,6 @@ public:
   void resetOutputSampleRate(double sampleRate) override { _setup(sampleRate); }
 
   EffectType Isa() const override { return EffectType::ReverbHi; }
+  double getTailTime() const override { return x150_x1d8_preDelay + x148_x1d0_time; }
 };
 } // namespace amuse
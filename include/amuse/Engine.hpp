@@ -6,13 +6,20 @@
 #include <memory>
 #include <random>
 #include <unordered_map>
+#include <vector>
 
 #include "amuse/AudioGroupSampleDirectory.hpp"
+#include "amuse/CommandQueue.hpp"
 #include "amuse/Emitter.hpp"
+#include "amuse/EngineStats.hpp"
 #include "amuse/IBackendVoiceAllocator.hpp"
 #include "amuse/Listener.hpp"
+#include "amuse/RenderPool.hpp"
+#include "amuse/Resampler.hpp"
+#include "amuse/SampleCache.hpp"
 #include "amuse/Sequencer.hpp"
 #include "amuse/Studio.hpp"
+#include "amuse/VoicePool.hpp"
 
 namespace amuse {
 class AudioGroup;
@@ -33,6 +40,7 @@ class Engine {
   friend class Emitter;
   friend class Sequencer;
   friend class Studio;
+  friend class Submix;
   friend class Voice;
   friend struct Sequencer::ChannelState;
 
@@ -40,6 +48,9 @@ class Engine {
   AmplitudeMode m_ampMode;
   std::unique_ptr<IMIDIReader> m_midiReader;
   std::unordered_map<const AudioGroupData*, std::unique_ptr<AudioGroup>> m_audioGroups;
+  ObjToken<VoicePool> m_voicePool;
+  size_t m_maxVoices;         /**< Engine-wide polyphony limit */
+  size_t m_numPolyVoices = 0; /**< Live voices counting toward m_maxVoices (excludes stolen voices) */
   std::list<ObjToken<Voice>> m_activeVoices;
   std::list<ObjToken<Emitter>> m_activeEmitters;
   std::list<ObjToken<Listener>> m_activeListeners;
@@ -50,28 +61,49 @@ class Engine {
   std::linear_congruential_engine<uint32_t, 0x41c64e6d, 0x3039, UINT32_MAX> m_random;
   int m_nextVid = 0;
   float m_masterVolume = 1.f;
+  float m_virtualThreshold = -1.f; /**< Gain at or below which voices stop decoding; negative disables */
+  double m_eventOffset = 0.0;      /**< Seconds into the current 5ms interval of the event being dispatched */
+  ResamplerQuality m_resamplerQuality = ResamplerQuality::Linear;
+  ResamplerQuality m_resamplerHighQuality = ResamplerQuality::Linear;
+  int m_resamplerHighPriority = 256; /**< Voices at or above use m_resamplerHighQuality; 256 disables */
   AudioChannelSet m_channelSet = AudioChannelSet::Unknown;
+  SampleCache m_sampleCache;
+  std::unique_ptr<RenderPool> m_renderPool; /**< Null when rendering serially */
+  EngineCycleStats m_cycleStats;            /**< Counters accumulating for the current pump cycle */
+  uint64_t m_cycleIndex = 0;
+  EngineProfiler m_profiler;
+  CommandQueue m_commandQueue;
 
   AudioGroup* _addAudioGroup(const AudioGroupData& data, std::unique_ptr<AudioGroup>&& grp);
   std::pair<AudioGroup*, const SongGroupIndex*> _findSongGroup(GroupId groupId) const;
   std::pair<AudioGroup*, const SFXGroupIndex*> _findSFXGroup(GroupId groupId) const;
 
+  bool _reserveVoice(uint8_t priority, uint8_t maxVoices, const void* limitTag);
+  std::unique_ptr<IBackendVoice> _bindBackendVoice(Voice& vox, double sampleRate, bool dynamicPitch);
   std::list<ObjToken<Voice>>::iterator _allocateVoice(const AudioGroup& group, GroupId groupId, double sampleRate,
-                                                      bool dynamicPitch, bool emitter, ObjToken<Studio> studio);
+                                                      bool dynamicPitch, bool emitter, ObjToken<Studio> studio,
+                                                      uint8_t priority = DefaultVoicePriority, uint8_t maxVoices = 0,
+                                                      const void* limitTag = nullptr);
   std::list<ObjToken<Sequencer>>::iterator _allocateSequencer(const AudioGroup& group, GroupId groupId, SongId setupId,
                                                               ObjToken<Studio> studio);
   ObjToken<Studio> _allocateStudio(bool mainOut);
   std::list<ObjToken<Voice>>::iterator _destroyVoice(std::list<ObjToken<Voice>>::iterator it);
   std::list<ObjToken<Sequencer>>::iterator _destroySequencer(std::list<ObjToken<Sequencer>>::iterator it);
   void _bringOutYourDead();
+  void _publishCycleStats();
 
 public:
   ~Engine();
-  Engine(IBackendVoiceAllocator& backend, AmplitudeMode ampMode = AmplitudeMode::PerSample);
+  Engine(IBackendVoiceAllocator& backend, AmplitudeMode ampMode = AmplitudeMode::PerSample,
+         size_t voiceCapacity = VoicePool::DefaultCapacity);
 
   /** Access voice backend of engine */
   IBackendVoiceAllocator& getBackend() { return m_backend; }
 
+  /** Queue for driving the engine from threads other than the one pumping the mixer.
+   *  All other Engine, Voice and Sequencer methods must be called on the mixing thread */
+  CommandQueue& getCommandQueue() { return m_commandQueue; }
+
   /** Access MIDI reader */
   IMIDIReader* getMIDIReader() const { return m_midiReader.get(); }
 
@@ -149,9 +181,21 @@ public:
     return seqPlay(group, groupId, songId, arrData, loop, m_defaultStudio);
   }
 
+  /** Cache fully decoded ADPCM samples within `bytes` of memory; 0 (default) disables the cache */
+  void setSampleCacheBudget(size_t bytes) { m_sampleCache.setBudget(bytes); }
+
+  /** Access decoded sample cache for tuning and hit/miss/eviction statistics */
+  SampleCache& getSampleCache() { return m_sampleCache; }
+  const SampleCache& getSampleCache() const { return m_sampleCache; }
+
   /** Set total volume of engine */
   void setVolume(float vol);
 
+  /** Place voices started from here on `offset` seconds into the current 5ms interval.
+   *  MIDI readers and sequencers set this before dispatching each event; it resets to 0 once they
+   *  have run, so voices started by other means begin at the interval start */
+  void setEventOffset(double offset) { m_eventOffset = offset; }
+
   /** Find voice from VoiceId */
   ObjToken<Voice> findVoice(int vid);
 
@@ -164,12 +208,59 @@ public:
   /** Obtain next random number from engine's PRNG */
   uint32_t nextRandom() { return m_random(); }
 
+  /** Set engine-wide polyphony limit; once reached, new voices steal the lowest-priority, oldest voice.
+   *  Starts at the constructor's voiceCapacity; voices are refused once every VoicePool slot is in use */
+  void setMaxVoices(size_t maxVoices) { m_maxVoices = maxVoices; }
+  size_t getMaxVoices() const { return m_maxVoices; }
+
+  /** Set gain at or below which voices go virtual: the codec is skipped while sample position,
+   *  macro state and envelopes keep advancing. 0 virtualizes silent voices; negative (default) disables */
+  void setVirtualVoiceThreshold(float threshold) { m_virtualThreshold = threshold; }
+  float getVirtualVoiceThreshold() const { return m_virtualThreshold; }
+
+  /** Set interpolation for backends that resample inside amuse (OfflineBackend and custom mixers).
+   *  Voices with priority at or above `highPriority` use `highQuality` instead, e.g. sinc for music
+   *  and linear for background SFX */
+  void setResamplerQuality(ResamplerQuality quality) {
+    m_resamplerQuality = m_resamplerHighQuality = quality;
+    m_resamplerHighPriority = 256;
+  }
+  void setResamplerQuality(ResamplerQuality quality, uint8_t highPriority, ResamplerQuality highQuality) {
+    m_resamplerQuality = quality;
+    m_resamplerHighQuality = highQuality;
+    m_resamplerHighPriority = highPriority;
+  }
+  ResamplerQuality getResamplerQuality(uint8_t priority) const {
+    return priority >= m_resamplerHighPriority ? m_resamplerHighQuality : m_resamplerQuality;
+  }
+
+  /** Shard per-block voice rendering over `threads` threads (including the mixing thread); 1 (default)
+   *  renders serially. Worker i is pinned to cpuAffinity[i % size] when affinity is given.
+   *  Only OfflineBackendVoiceAllocator consults the pool; with BooBackend, boo's mixer thread pulls
+   *  each voice serially and this setting has no effect */
+  void setRenderThreads(size_t threads, const std::vector<int>& cpuAffinity = {});
+  size_t getRenderThreads() const { return m_renderPool ? m_renderPool->getNumThreads() : 1; }
+
+  /** Pool for backends to render voices in parallel, or null when rendering serially.
+   *  Voice::supplyAudio/routeAudio may run concurrently on distinct voices once every voice's
+   *  preSupplyAudio has run (serially, in a fixed order); mix results in that same order to
+   *  stay bit-identical with serial rendering */
+  RenderPool* getRenderPool() { return m_renderPool.get(); }
+
+  /** Access preallocated voice storage for capacity and overflow statistics */
+  const VoicePool& getVoicePool() const { return *m_voicePool; }
+
   /** Obtain list of active voices */
   std::list<ObjToken<Voice>>& getActiveVoices() { return m_activeVoices; }
 
   /** Obtain total active voice count (including child voices) */
   size_t getNumTotalActiveVoices() const;
 
+  /** Counters of the most recently completed pump cycle, with rolling history for percentiles.
+   *  Lock-free with respect to the mixing thread; call from one thread at a time.
+   *  The returned reference stays valid until the next getStats() call */
+  const EngineStatsSnapshot& getStats() { return m_profiler.snapshot(); }
+
   /** Obtain list of active sequencers */
   std::list<ObjToken<Sequencer>>& getActiveSequencers() { return m_activeSequencers; }
 
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace amuse {
+
+/** Adds the wall time of the enclosing scope, in seconds, to a counter */
+class ProfileScope {
+  std::chrono::steady_clock::time_point m_start;
+  double& m_accum;
+
+public:
+  explicit ProfileScope(double& accum) : m_start(std::chrono::steady_clock::now()), m_accum(accum) {}
+  ~ProfileScope() { m_accum += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count(); }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+/** Time spent in one processing stage across all voices (or submixes) of a cycle */
+struct StageTime {
+  double m_total = 0.0; /**< Summed seconds */
+  double m_max = 0.0;   /**< Largest contribution of a single voice (or submix) */
+
+  void add(double time) {
+    m_total += time;
+    if (time > m_max)
+      m_max = time;
+  }
+};
+
+/** Counters gathered over one engine pump cycle */
+struct EngineCycleStats {
+  uint64_t m_cycle = 0;        /**< Index of this cycle since engine creation */
+  double m_audioTime = 0.0;    /**< Seconds of audio advanced by the cycle's 5ms intervals */
+  double m_intervalTime = 0.0; /**< Seconds in Engine::_on5MsInterval (MIDI, sequencers, emitters) */
+  StageTime m_preSupply;       /**< Voice::preSupplyAudio (SoundMacro execution, envelopes) */
+  StageTime m_supply;          /**< Voice::supplyAudio (sample decode and amplitude) */
+  StageTime m_route;           /**< Voice::routeAudio (bus gains) */
+  StageTime m_effects;         /**< Submix::applyEffect, maximum taken per submix */
+  uint32_t m_numVoices = 0;    /**< Active voices at end of cycle, including children */
+  uint32_t m_numSequencers = 0;
+  uint32_t m_numEmitters = 0;
+  uint32_t m_voicesStarted = 0;
+  uint32_t m_voicesKilled = 0;
+
+  /** Engine-side processing time of the cycle (excludes backend resampling and mixing) */
+  double cpuTime() const {
+    return m_intervalTime + m_preSupply.m_total + m_supply.m_total + m_route.m_total + m_effects.m_total;
+  }
+
+  /** Fraction of real time spent processing; 1.0 means the cycle's audio took as long to make as to play */
+  double load() const { return m_audioTime > 0.0 ? cpuTime() / m_audioTime : 0.0; }
+};
+
+/** Percentiles over an EngineStatsSnapshot's rolling history */
+struct EngineStatsPercentiles {
+  float m_p50 = 0.f;
+  float m_p90 = 0.f;
+  float m_p99 = 0.f;
+  float m_max = 0.f;
+};
+
+/** Most recent cycle's counters plus per-cycle history for the last HistorySize cycles */
+struct EngineStatsSnapshot {
+  static constexpr size_t HistorySize = 256;
+
+  EngineCycleStats m_last;
+  size_t m_historyCount = 0;                      /**< Valid entries in the history arrays (unordered) */
+  std::array<float, HistorySize> m_cpuHistory{};  /**< EngineCycleStats::cpuTime() per cycle */
+  std::array<float, HistorySize> m_loadHistory{}; /**< EngineCycleStats::load() per cycle */
+
+  EngineStatsPercentiles cpuTimePercentiles() const;
+  EngineStatsPercentiles loadPercentiles() const;
+};
+
+/** Publishes per-cycle counters from the mixing thread through a lock-free triple buffer.
+ *  publish() never blocks the mixing thread; snapshot() always returns the newest complete cycle.
+ *  There may be one publishing and one reading thread at a time. */
+class EngineProfiler {
+  static constexpr uint8_t FreshBit = 0x4;
+  static constexpr uint8_t IndexMask = 0x3;
+
+  std::array<EngineStatsSnapshot, 3> m_buffers;
+  uint8_t m_back = 0;                  /**< Publisher-owned */
+  std::atomic<uint8_t> m_middle = {1}; /**< Exchanged between threads; FreshBit marks unread data */
+  uint8_t m_front = 2;                 /**< Reader-owned */
+  std::array<float, EngineStatsSnapshot::HistorySize> m_cpuRing{};
+  std::array<float, EngineStatsSnapshot::HistorySize> m_loadRing{};
+  size_t m_ringPos = 0;
+  size_t m_ringCount = 0;
+
+public:
+  /** Record a finished cycle; called from the mixing thread */
+  void publish(const EngineCycleStats& stats);
+
+  /** Obtain the newest published cycle and history; valid until the next snapshot() call */
+  const EngineStatsSnapshot& snapshot();
+};
+
+} // namespace amuse
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace amuse {
+
+/** Real-input FFT of a fixed power-of-two size (at least 16), computed as a half-size complex transform.
+ *  Spectra are stored split into separate real and imaginary arrays of spectrumStride() floats each;
+ *  bins [0, size/2] are meaningful and the padding past them is kept zero, so spectra may be processed
+ *  four bins at a time. */
+class FFT {
+  size_t m_size;                         /**< Real transform size N */
+  std::vector<uint32_t> m_bitRev;        /**< Bit-reversal permutation of the N/2-point complex transform */
+  std::vector<float> m_twRe, m_twIm;     /**< Butterfly twiddles; stage with half-span h starts at index h - 1 */
+  std::vector<float> m_postRe, m_postIm; /**< e^(-2*pi*i*k/N) for k in [0, N/4], splitting the packed spectrum */
+
+  void _complexTransform(float* re, float* im) const;
+
+public:
+  explicit FFT(size_t size);
+
+  size_t size() const { return m_size; }
+
+  /** Floats in each of the real and imaginary arrays of a spectrum (N/2 + 1 bins, padded to a multiple of 4) */
+  size_t spectrumStride() const { return m_size / 2 + 4; }
+
+  /** Transform `size()` real samples into a split spectrum */
+  void forward(const float* in, float* re, float* im) const;
+
+  /** Inverse transform of a split spectrum into `size()` real samples, scaled by size().
+   *  The spectrum arrays are used as workspace and left undefined. */
+  void inverse(float* re, float* im, float* out) const;
+
+  /** acc += a * b over `count` complex bins of split spectra (a multiple of 4, e.g. spectrumStride()) */
+  static void MultiplyAccumulate(float* accRe, float* accIm, const float* aRe, const float* aIm, const float* bRe,
+                                 const float* bIm, size_t count);
+};
+
+} // namespace amuse
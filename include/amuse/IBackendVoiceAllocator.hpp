@@ -28,6 +28,16 @@ public:
   /** Amuse obtains a new voice from the platform this way */
   virtual std::unique_ptr<IBackendVoice> allocateVoice(Voice& clientVox, double sampleRate, bool dynamicPitch) = 0;
 
+  /** Amuse offers a voice whose client is being destroyed this way; return true after stopping it and
+   *  detaching it from its client so it may be kept for reuseVoice(), false to have it destroyed */
+  virtual bool releaseVoice(IBackendVoice& voice) { return false; }
+
+  /** Amuse rebinds a voice previously accepted by releaseVoice() to a new client this way, leaving it as
+   *  allocateVoice() would; return false to have a fresh voice allocated instead */
+  virtual bool reuseVoice(IBackendVoice& voice, Voice& clientVox, double sampleRate, bool dynamicPitch) {
+    return false;
+  }
+
   /** Amuse obtains a new submix from the platform this way */
   virtual std::unique_ptr<IBackendSubmix> allocateSubmix(Submix& clientSmx, bool mainOut, int busId) = 0;
 
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace amuse {
+
+/** Timestamped run of raw MIDI bytes as received from a device */
+struct MIDIEvent {
+  static constexpr size_t InlineBytes = 12;
+
+  double m_time = 0.0;     /**< Receive time in seconds, in the device's clock */
+  uint32_t m_len = 0;      /**< Total bytes, inline or spilled */
+  size_t m_arenaPos = 0;   /**< Start in the sysex arena when m_len exceeds InlineBytes */
+  uint8_t m_bytes[InlineBytes];
+};
+
+/** Preallocated single-producer/single-consumer queue of MIDIEvents.
+ *  Short messages are stored inline; longer ones (sysex) spill into a byte arena that is reclaimed
+ *  as events are popped. Neither side locks or allocates; push() drops the event when full. */
+class MIDIEventQueue {
+public:
+  static constexpr size_t DefaultEventCapacity = 1024;
+  static constexpr size_t DefaultArenaCapacity = 16384;
+
+private:
+  std::unique_ptr<MIDIEvent[]> m_events;
+  size_t m_eventMask;
+  std::unique_ptr<uint8_t[]> m_arena;
+  size_t m_arenaMask;
+
+  alignas(64) std::atomic<size_t> m_head = {0}; /**< Written by producer */
+  size_t m_arenaHead = 0;                       /**< Producer-owned */
+  alignas(64) std::atomic<size_t> m_tail = {0}; /**< Written by consumer */
+  std::atomic<size_t> m_arenaTail = {0};        /**< Written by consumer */
+
+public:
+  explicit MIDIEventQueue(size_t eventCapacity = DefaultEventCapacity,
+                          size_t arenaCapacity = DefaultArenaCapacity);
+
+  MIDIEventQueue(const MIDIEventQueue&) = delete;
+  MIDIEventQueue& operator=(const MIDIEventQueue&) = delete;
+
+  /** Largest message push() can accept */
+  size_t maxMessageSize() const { return m_arenaMask + 1; }
+
+  /** Producer: queue `len` bytes received at `time`; returns false (dropping them) when full */
+  bool push(double time, const uint8_t* data, size_t len);
+
+  /** Consumer: oldest queued event, or null when empty */
+  const MIDIEvent* front() const;
+
+  /** Consumer: copy an event's bytes (ev.m_len of them) to `out` */
+  void copyBytes(const MIDIEvent& ev, uint8_t* out) const;
+
+  /** Consumer: release the event returned by front() */
+  void pop();
+};
+
+} // namespace amuse
@@ -10,7 +10,20 @@ constexpr int16_t N64MusyXSampClamp(int32_t val) {
   return val;
 }
 
+/** Codebook expanded into per-entry prediction matrices.
+ *  Each 8-sample group decodes as one 8x10 matrix-vector product over
+ *  (last1, last2, residual[0..7]); columns are stored pairwise per 4-row half */
+struct N64MusyXPredictor {
+  alignas(16) int16_t m_mtx[8][5][2][8];
+  explicit N64MusyXPredictor(const int16_t coefs[8][2][8]);
+};
+
 unsigned N64MusyXDecompressFrame(int16_t* out, const uint8_t* in, const int16_t coefs[8][2][8], unsigned lastSample);
 
 unsigned N64MusyXDecompressFrameRanged(int16_t* out, const uint8_t* in, const int16_t coefs[8][2][8],
                                        unsigned firstSample, unsigned lastSample);
+
+unsigned N64MusyXDecompressFrame(int16_t* out, const uint8_t* in, const N64MusyXPredictor& pred, unsigned lastSample);
+
+unsigned N64MusyXDecompressFrameRanged(int16_t* out, const uint8_t* in, const N64MusyXPredictor& pred,
+                                       unsigned firstSample, unsigned lastSample);
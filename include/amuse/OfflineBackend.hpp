@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "amuse/IBackendSubmix.hpp"
+#include "amuse/IBackendVoice.hpp"
+#include "amuse/IBackendVoiceAllocator.hpp"
+#include "amuse/Resampler.hpp"
+
+namespace amuse {
+class OfflineBackendSubmix;
+class OfflineBackendVoiceAllocator;
+
+/** Backend voice implementation for the headless offline mixer */
+class OfflineBackendVoice : public IBackendVoice {
+  friend class OfflineBackendVoiceAllocator;
+
+  /** Channel gains into one submix, slewed across a block when requested */
+  struct Binding {
+    OfflineBackendSubmix* m_submix;
+    std::array<float, 8> m_curCoefs{};
+    std::array<float, 8> m_targetCoefs{};
+    bool m_slewing = false;
+    std::vector<float> m_routed; /**< Bus-processed mono output for current block */
+  };
+
+  OfflineBackendVoiceAllocator& m_parent;
+  Voice* m_clientVox; /**< Null while parked in a voice pool slot */
+  double m_sampleRate;
+  double m_pitchRatio = 1.0;
+  bool m_dynamicPitch;
+  bool m_running = false;
+
+  std::vector<Binding> m_bindings;
+  std::vector<std::vector<float>> m_routedSpare; /**< Routing buffers of dropped bindings, kept for reuse */
+  std::vector<int16_t> m_decodeBuf;              /**< Scratch for samples pulled from client voice */
+  Resampler m_resampler;                         /**< Voice rate to output rate, quality chosen by the engine */
+  std::vector<float> m_outBuf;                   /**< Resampled mono output for current block */
+
+  void _render(size_t frames, double dt);
+  void _mix(size_t frames);
+
+public:
+  OfflineBackendVoice(OfflineBackendVoiceAllocator& parent, Voice& clientVox, double sampleRate, bool dynamicPitch);
+  ~OfflineBackendVoice() override;
+
+  void resetSampleRate(double sampleRate) override;
+  void resetChannelLevels() override;
+  void setChannelLevels(IBackendSubmix* submix, const std::array<float, 8>& coefs, bool slew) override;
+  void setPitchRatio(double ratio, bool slew) override;
+  void start() override;
+  void stop() override;
+};
+
+/** Backend submix implementation for the headless offline mixer */
+class OfflineBackendSubmix : public IBackendSubmix {
+  friend class OfflineBackendVoiceAllocator;
+  friend class OfflineBackendVoice;
+
+  OfflineBackendVoiceAllocator& m_parent;
+  Submix& m_clientSmx;
+  bool m_mainOut;
+  int m_busId;
+  std::vector<std::pair<OfflineBackendSubmix*, float>> m_sends;
+  std::vector<float> m_buf; /**< Interleaved mix for current block */
+
+public:
+  OfflineBackendSubmix(OfflineBackendVoiceAllocator& parent, Submix& clientSmx, bool mainOut, int busId);
+  ~OfflineBackendSubmix() override;
+
+  void setSendLevel(IBackendSubmix* submix, float level, bool slew) override;
+  double getSampleRate() const override;
+  SubmixFormat getSampleFormat() const override;
+};
+
+/** Backend voice allocator that mixes in software on the calling thread, without boo or device threads.
+ *  Call pumpAndMix() to render any number of interleaved float frames; voices are resampled at the
+ *  engine's resampler quality for their priority, processed in 5ms blocks and spread across the engine's
+ *  RenderPool when one is configured (see Engine::setRenderThreads). */
+class OfflineBackendVoiceAllocator : public IBackendVoiceAllocator {
+  friend class OfflineBackendVoice;
+  friend class OfflineBackendSubmix;
+
+  double m_sampleRate;
+  AudioChannelSet m_channelSet;
+  ChannelMap m_chanMap;
+  size_t m_5msFrames;
+  float m_volume = 1.f;
+  Engine* m_cbInterface = nullptr;
+
+  std::vector<OfflineBackendVoice*> m_voices;      /**< Allocation order; null entries are compacted per block */
+  std::vector<OfflineBackendSubmix*> m_submixes;   /**< Allocation order; null entries are compacted per block */
+  std::vector<OfflineBackendVoice*> m_blockVoices; /**< Voices rendering in the current block */
+  std::vector<float> m_blockBuf;                   /**< Interleaved output of current block */
+  size_t m_blockPos = 0;                           /**< Frames of m_blockBuf already handed out */
+
+  void _pumpBlock();
+
+public:
+  explicit OfflineBackendVoiceAllocator(double sampleRate = 48000.0,
+                                        AudioChannelSet channelSet = AudioChannelSet::Stereo);
+
+  std::unique_ptr<IBackendVoice> allocateVoice(Voice& clientVox, double sampleRate, bool dynamicPitch) override;
+  bool releaseVoice(IBackendVoice& voice) override;
+  bool reuseVoice(IBackendVoice& voice, Voice& clientVox, double sampleRate, bool dynamicPitch) override;
+  std::unique_ptr<IBackendSubmix> allocateSubmix(Submix& clientSmx, bool mainOut, int busId) override;
+  std::vector<std::pair<std::string, std::string>> enumerateMIDIDevices() override;
+  std::unique_ptr<IMIDIReader> allocateMIDIReader(Engine& engine) override;
+  void setCallbackInterface(Engine* engine) override;
+  AudioChannelSet getAvailableSet() override;
+  void setVolume(float vol) override;
+
+  /** Render `frames` interleaved frames of getChannelCount() channels into `out` */
+  void pumpAndMix(float* out, size_t frames);
+
+  double getSampleRate() const { return m_sampleRate; }
+  size_t getChannelCount() const { return m_chanMap.m_channelCount; }
+  const ChannelMap& getChannelMap() const { return m_chanMap; }
+};
+} // namespace amuse
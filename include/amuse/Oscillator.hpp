@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+namespace amuse {
+
+/** Phase-accumulating modulation oscillator shared by LFO controllers, tremolo and vibrato.
+ *  Phase advances incrementally at control rate, so waveforms stay continuous across period
+ *  changes and reading the output costs a table lookup rather than a transcendental call. */
+class Oscillator {
+  float m_period = 0.f; /**< Seconds per cycle; negative runs backwards, 0 disables */
+  double m_phase = 0.0; /**< Normalized phase in [0, 1) */
+
+public:
+  /** Set cycle period in seconds, preserving current phase */
+  void setPeriod(float period);
+  float getPeriod() const { return m_period; }
+
+  /** Determine if oscillator has a usable period */
+  bool isActive() const { return m_period != 0.f; }
+
+  /** Restart cycle at phase 0 */
+  void reset() { m_phase = 0.0; }
+
+  /** Step phase forward by `dt` seconds */
+  void advance(double dt);
+
+  float getPhase() const { return float(m_phase); }
+
+  /** Sine of current phase in [-1, 1] */
+  float sine() const;
+
+  /** Triangle of current phase in [-1, 1], starting at 0 and rising */
+  float triangle() const;
+};
+
+} // namespace amuse
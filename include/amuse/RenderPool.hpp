@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace amuse {
+
+/** Work-stealing thread pool used to shard per-block voice rendering.
+ *  parallelFor() splits an index range evenly across the workers and the calling thread; a worker
+ *  that drains its share steals from the back of another's. The caller blocks until every index
+ *  has been processed, so results written to per-index storage can be reduced in a fixed order. */
+class RenderPool {
+  using TaskFunc = void (*)(void* ctx, size_t idx);
+
+  /** Remaining [begin, end) of a slot's share, packed as (begin << 32 | end) */
+  struct alignas(64) Range {
+    std::atomic<uint64_t> m_range = {0};
+  };
+
+  std::vector<std::thread> m_threads;
+  std::unique_ptr<Range[]> m_ranges; /**< One per worker plus one for the calling thread (slot 0) */
+  std::mutex m_lock;
+  std::condition_variable m_startCv;
+  std::condition_variable m_doneCv;
+  uint64_t m_generation = 0;
+  size_t m_busy = 0;
+  bool m_quit = false;
+  TaskFunc m_func = nullptr;
+  void* m_ctx = nullptr;
+
+  bool _popFront(size_t slot, size_t& idx);
+  bool _stealBack(size_t slot, size_t& idx);
+  void _work(size_t slot);
+  void _workerThread(size_t slot, int cpu);
+  void _run(size_t count, TaskFunc func, void* ctx);
+
+public:
+  /** Start `threads - 1` workers (the caller of parallelFor acts as the remaining one).
+   *  When `cpuAffinity` is non-empty, worker i is pinned to cpuAffinity[i % size] where supported */
+  explicit RenderPool(size_t threads, const std::vector<int>& cpuAffinity = {});
+  ~RenderPool();
+
+  RenderPool(const RenderPool&) = delete;
+  RenderPool& operator=(const RenderPool&) = delete;
+
+  /** Total threads participating in parallelFor, including the caller */
+  size_t getNumThreads() const { return m_threads.size() + 1; }
+
+  /** Invoke `func(i)` for each i in [0, count) across the pool; returns once all have completed */
+  template <typename Func>
+  void parallelFor(size_t count, Func&& func) {
+    using FuncType = std::remove_reference_t<Func>;
+    _run(
+        count, [](void* ctx, size_t idx) { (*static_cast<FuncType*>(ctx))(idx); },
+        const_cast<void*>(static_cast<const void*>(&func)));
+  }
+};
+
+} // namespace amuse
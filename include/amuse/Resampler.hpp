@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace amuse {
+
+enum class ResamplerQuality {
+  Linear, /**< 2-point linear interpolation; cheapest, dulls highs and aliases on pitch-up */
+  Cubic,  /**< 4-point Catmull-Rom interpolation */
+  Sinc    /**< 16-tap Kaiser-windowed sinc, polyphase with interpolated phases, band-limited to the step */
+};
+
+/** Streaming mono resampler converting a voice's sample rate (scaled by its pitch ratio) to an output rate.
+ *  For backends that mix in amuse rather than delegating pitch to the audio API.
+ *  Input is pushed as inputNeeded() asks and consumed as output is produced; retained history keeps
+ *  interpolation continuous across blocks and across quality changes. */
+class Resampler {
+public:
+  static constexpr size_t SincTaps = 16;
+  static constexpr size_t SincPhases = 128;
+
+private:
+  ResamplerQuality m_quality;
+  std::vector<float> m_inBuf; /**< halfTaps()-1 samples of history followed by pending input */
+  double m_inPos = 0.0;       /**< Fractional read position past the history */
+
+  size_t _halfTaps() const { return _HalfTaps(m_quality); }
+  static size_t _HalfTaps(ResamplerQuality quality);
+
+public:
+  explicit Resampler(ResamplerQuality quality = ResamplerQuality::Linear);
+
+  /** Change interpolation without a discontinuity */
+  void setQuality(ResamplerQuality quality);
+  ResamplerQuality getQuality() const { return m_quality; }
+
+  /** Drop history and pending input (e.g. on sample rate change) */
+  void reset();
+
+  /** Input samples to push before process() can produce `frames` outputs advancing `step` inputs each */
+  size_t inputNeeded(size_t frames, double step) const;
+
+  /** Append `count` voice-rate samples */
+  void pushInput(const int16_t* in, size_t count);
+
+  /** Append `count` voice-rate samples already normalized to [-1, 1] */
+  void pushInput(const float* in, size_t count);
+
+  /** Produce `frames` outputs, advancing `step` (input rate / output rate) input samples per output */
+  void process(float* out, size_t frames, double step);
+};
+
+} // namespace amuse
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "amuse/AudioGroupSampleDirectory.hpp"
+#include "amuse/Common.hpp"
+
+namespace amuse {
+class AudioGroup;
+
+/** Fully decoded PCM of one sample entry, shared by every voice playing it */
+struct DecodedSample {
+  ObjToken<SampleEntryData> m_entry; /**< Entry decoded from; a reloaded loose sample invalidates the cache line */
+  std::unique_ptr<int16_t[]> m_pcm;  /**< Native-endian PCM */
+  uint32_t m_numSamples = 0;
+
+  size_t byteSize() const { return m_numSamples * sizeof(int16_t); }
+};
+
+/** LRU cache of decoded ADPCM samples, bounded by a byte budget.
+ *  Disabled (budget of 0) unless enabled on the owning Engine */
+class SampleCache {
+public:
+  struct Stats {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    size_t m_residentBytes = 0;
+    size_t m_residentSamples = 0;
+  };
+
+private:
+  struct Key {
+    const AudioGroup* m_group;
+    SampleId m_sampleId;
+    bool operator==(const Key& other) const { return m_group == other.m_group && m_sampleId == other.m_sampleId; }
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return std::hash<const AudioGroup*>()(key.m_group) ^ (std::hash<SampleId>()(key.m_sampleId) << 1);
+    }
+  };
+  using LRUList = std::list<std::pair<Key, ObjToken<DecodedSample>>>;
+
+  LRUList m_lru; /**< Most recently used at front */
+  std::unordered_map<Key, LRUList::iterator, KeyHash> m_lookup;
+  size_t m_budget = 0;
+  size_t m_maxEntryBytes = 256 * 1024;
+  Stats m_stats;
+
+  void _evict(LRUList::iterator it);
+  void _trim(size_t budget);
+
+public:
+  /** Set total byte budget for resident PCM; 0 disables caching and releases all entries */
+  void setBudget(size_t bytes);
+  size_t getBudget() const { return m_budget; }
+
+  /** Set largest decoded sample size admitted to the cache (keeps key-on decode bounded) */
+  void setMaxEntryBytes(size_t bytes) { m_maxEntryBytes = bytes; }
+  size_t getMaxEntryBytes() const { return m_maxEntryBytes; }
+
+  /** Obtain decoded PCM for sample, decoding and inserting on miss.
+   *  Returns an empty token when caching is disabled or the sample is not cacheable */
+  ObjToken<DecodedSample> lookup(const AudioGroup& group, SampleId sampleId, const ObjToken<SampleEntryData>& entry,
+                                 const unsigned char* data);
+
+  /** Release all entries decoded from `group` */
+  void purgeGroup(const AudioGroup& group);
+
+  /** Release all entries */
+  void clear();
+
+  const Stats& getStats() const { return m_stats; }
+  void resetStats();
+};
+} // namespace amuse
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+#include "amuse/AudioGroupSampleDirectory.hpp"
+#include "amuse/Common.hpp"
+
+namespace amuse {
+
+/** Background service watching a group directory for edits to loose sample files (.wav, .dsp, .vadpcm).
+ *  Changes set the owning entry's m_looseDirty flag so playback never has to stat the filesystem.
+ *  Uses inotify on Linux and falls back to polling file modification times elsewhere. */
+class SampleFileWatcher {
+  struct Watch {
+    ObjToken<SampleEntry> m_entry;
+    time_t m_lastModTime = 0;   /**< Newest mtime seen by the polling fallback */
+    bool m_haveModTime = false; /**< m_lastModTime holds a baseline; the first poll after registering takes it */
+  };
+
+  std::string m_dirPath;
+  std::mutex m_watchLock;
+  std::unordered_map<std::string, Watch> m_watches; /**< Keyed on file name without extension */
+  std::atomic_bool m_running = {true};
+  std::condition_variable m_pollCv;
+  std::thread m_thread;
+#if __linux__
+  int m_inotifyFd = -1;
+  void _inotifyThread();
+#endif
+  void _pollThread();
+  void _markDirty(std::string_view fileName);
+  time_t _pollModTime(const std::string& baseName) const;
+
+public:
+  /** Interval between modification time scans when native notification is unavailable */
+  static constexpr int PollIntervalMs = 500;
+
+  explicit SampleFileWatcher(std::string_view dirPath);
+  ~SampleFileWatcher();
+
+  SampleFileWatcher(const SampleFileWatcher&) = delete;
+  SampleFileWatcher& operator=(const SampleFileWatcher&) = delete;
+
+  /** Register (or re-register) entry backed by `baseName` + {.wav,.dsp,.vadpcm} within the watched directory.
+   *  Only updates the watch table; any filesystem access happens on the watcher thread. */
+  void watchSample(std::string_view baseName, const ObjToken<SampleEntry>& entry);
+
+  /** Stop reporting changes for `baseName` */
+  void unwatchSample(std::string_view baseName);
+
+  std::string_view getDirPath() const { return m_dirPath; }
+};
+
+} // namespace amuse
@@ -18,7 +18,8 @@ class Voice;
 /** Real-time state of SoundMacro execution */
 struct SoundMacroState {
   /** 'program counter' stack for the active SoundMacro */
-  std::vector<std::tuple<ObjectId, const SoundMacro*, int>> m_pc;
+  using PCStack = std::vector<std::tuple<ObjectId, const SoundMacro*, int>>;
+  PCStack m_pc;
   void _setPC(int pc) { std::get<2>(m_pc.back()) = std::get<1>(m_pc.back())->assertPC(pc); }
 
   double m_ticksPerSec; /**< ratio for resolving ticks in commands that use them */
@@ -70,12 +71,16 @@ struct SoundMacroState {
       : m_midiCtrl(midiCtrl), m_scale(scale), m_combine(combine), m_varType(varType) {}
     };
     std::vector<Component> m_comps; /**< Components built up by the macro */
+    bool m_timeVarying = false;     /**< Formula reads an LFO and so varies within a mixing block */
 
     /** Combine additional component(s) to formula */
     void addComponent(uint8_t midiCtrl, float scale, Combine combine, VarType varType);
 
     /** Calculate value */
-    float evaluate(double time, const Voice& vox, const SoundMacroState& st) const;
+    float evaluate(const Voice& vox, const SoundMacroState& st) const;
+
+    /** Determine if value may change between block endpoints (and must be interpolated) */
+    bool isTimeVarying() const { return m_timeVarying; }
 
     /** Determine if able to use */
     explicit operator bool() const { return m_comps.size() != 0; }
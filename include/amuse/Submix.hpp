@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
 #include "amuse/EffectBase.hpp"
 #include "amuse/EffectChorus.hpp"
+#include "amuse/EffectConvolution.hpp"
 #include "amuse/EffectDelay.hpp"
 #include "amuse/EffectReverb.hpp"
 #include "amuse/IBackendSubmix.hpp"
@@ -24,8 +26,17 @@ class Submix {
   Engine& m_root;
   std::unique_ptr<IBackendSubmix> m_backendSubmix;                /**< Handle to client-implemented backend submix */
   std::vector<std::unique_ptr<EffectBaseTypeless>> m_effectStack; /**< Ordered list of effects to apply to submix */
+  mutable std::atomic<float> m_effectTime = {0.f};                /**< Seconds in most recent applyEffect */
+  mutable double m_silentTime = 0.0;                              /**< Seconds since the input was last audible */
+  mutable std::atomic<bool> m_sleeping = {false};                 /**< Tail decayed; effects skipped until input */
+
+  template <typename T>
+  void _applyEffect(T* audio, size_t frameCount, const ChannelMap& chanMap) const;
 
 public:
+  /** Mean-square level (about -90dBFS) below which effect input and output count as silent */
+  static constexpr float SilenceEnergy = 1e-9f;
+
   Submix(Engine& engine);
 
   /** Construct new effect */
@@ -61,6 +72,12 @@ public:
   /** Add new chorus effect to effect stack and assume ownership */
   EffectChorus& makeChorus(const EffectChorusInfo& info);
 
+  /** Add new convolution reverb to effect stack and assume ownership; the IR loads in the background */
+  EffectConvolution& makeConvolution(std::string_view irPath, float mix);
+
+  /** Add new convolution reverb to effect stack and assume ownership; the IR loads in the background */
+  EffectConvolution& makeConvolution(const EffectConvolutionInfo& info);
+
   /** Add new delay effect to effect stack and assume ownership */
   EffectDelay& makeDelay(uint32_t initDelay, uint32_t initFeedback, uint32_t initOutput);
 
@@ -94,6 +111,16 @@ public:
   /** in/out transformation entry for audio effect */
   void applyEffect(float* audio, size_t frameCount, const ChannelMap& chanMap) const;
 
+  /** Seconds spent in the most recent applyEffect call; readable from any thread */
+  float getEffectTime() const { return m_effectTime.load(std::memory_order_relaxed); }
+
+  /** Seconds the effect stack rings after its input falls silent (each effect's tail, in series) */
+  double getTailTime() const;
+
+  /** True while the effect stack is idle: input has been silent for its tail and the output has decayed,
+   *  so applyEffect zeroes the output without processing. Readable from any thread */
+  bool isSleeping() const { return m_sleeping.load(std::memory_order_relaxed); }
+
   /** advice effects of changing sample rate */
   void resetOutputSampleRate(double sampleRate);
 
@@ -1,16 +1,18 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstdlib>
 #include <list>
 #include <memory>
-#include <queue>
 
 #include "amuse/AudioGroup.hpp"
 #include "amuse/AudioGroupSampleDirectory.hpp"
 #include "amuse/Entity.hpp"
 #include "amuse/Envelope.hpp"
+#include "amuse/Oscillator.hpp"
+#include "amuse/SampleCache.hpp"
 #include "amuse/SoundMacroState.hpp"
 #include "amuse/Studio.hpp"
 
@@ -22,7 +24,11 @@ constexpr float convertMusyXPanToAmusePan(uint32_t pan) {
   return std::clamp(static_cast<float>(pan - 64) / 63.f, -1.f, 1.f);
 }
 
+/** Priority given to voices started without an explicit priority (matches SETPRIO/PLAYMACRO defaults) */
+constexpr uint8_t DefaultVoicePriority = 50;
+
 class IBackendVoice;
+class VoicePool;
 struct Keymap;
 struct LayerMapping;
 
@@ -65,6 +71,39 @@ class Voice : public Entity {
     int8_t m_width; /**< delta pan value to target of PANNING command */
   };
 
+  /** Fixed ring of pending PANNING/SPANNING sweeps, run one after another */
+  struct PanningQueue {
+    static constexpr size_t Capacity = 8; /**< Pending sweeps held per voice */
+    std::array<Panning, Capacity> m_sweeps;
+    uint8_t m_head = 0;
+    uint8_t m_count = 0;
+
+    bool empty() const { return m_count == 0; }
+    Panning& front() { return m_sweeps[m_head]; }
+    void pop() {
+      m_head = (m_head + 1) % Capacity;
+      --m_count;
+    }
+    Panning& at(size_t i) { return m_sweeps[(m_head + i) % Capacity]; }
+    /** When full, the two oldest pending sweeps (behind the active one) are coalesced into a single
+     *  sweep from the first's start to the second's end over their combined duration, so every
+     *  queued target is still reached on schedule */
+    void push(const Panning& p) {
+      if (m_count == Capacity) {
+        Panning& first = at(1);
+        const Panning& second = at(2);
+        const int end = second.m_pos + second.m_width;
+        first.m_dur += second.m_dur;
+        first.m_width = int8_t(std::clamp(end - first.m_pos, -128, 127));
+        for (size_t i = 2; i + 1 < m_count; ++i)
+          at(i) = at(i + 1);
+        --m_count;
+      }
+      at(m_count) = p;
+      ++m_count;
+    }
+  };
+
   void _setObjectId(ObjectId id) { m_objectId = id; }
 
   int m_vid;                        /**< VoiceID of this voice instance */
@@ -81,8 +120,15 @@ class Voice : public Entity {
   std::list<ObjToken<Voice>> m_childVoices;   /**< Child voices for PLAYMACRO usage */
   uint8_t m_keygroup = 0;                     /**< Keygroup voice is a member of */
 
+  uint8_t m_priority = DefaultVoicePriority; /**< Stealing priority; lowest priority voices are stolen first */
+  float m_ageCount = 65535.f;                /**< Age counter; among equal priorities, lowest count is stolen first */
+  float m_ageSpeed = 65535.f / 1080.f;       /**< Age counter decrement per second */
+  const void* m_limitTag = nullptr;          /**< Page/SFX/PLAYMACRO entry this voice counts against for maxVoices */
+  float m_stealFade = -1.f;                  /**< Remaining gain while fading out after being stolen, -1 otherwise */
+
   ObjToken<SampleEntryData> m_curSample;          /**< Current sample entry playing */
   const unsigned char* m_curSampleData = nullptr; /**< Current sample data playing */
+  ObjToken<DecodedSample> m_curDecoded;           /**< Cached decoded PCM backing m_curSampleData (if any) */
   SampleFormat m_curFormat;                       /**< Current sample format playing */
   uint32_t m_curSamplePos = 0;                    /**< Current sample position */
   uint32_t m_lastSamplePos = 0;                   /**< Last sample position (or last loop sample) */
@@ -91,11 +137,12 @@ class Voice : public Entity {
   double m_dopplerRatio = 1.0;                    /**< Current ratio to mix with chromatic pitch for doppler effects */
   double m_sampleRate = NativeSampleRate; /**< Current sample rate computed from relative sample key or SETPITCH */
   double m_voiceTime = 0.0;               /**< Current seconds of voice playback (per-sample resolution) */
+  double m_startOffset = 0.0;             /**< Seconds of silence before the first rendered sample */
   uint64_t m_voiceSamples = 0;            /**< Count of samples processed over voice's lifetime */
   float m_lastLevel = 0.f;                /**< Last computed level ([0,1] mapped to [-10,0] clamped decibels) */
   float m_nextLevel = 0.f;                /**< Next computed level used for lerp-mode amplitude */
-  VolumeCache m_nextLevelCache;
-  VolumeCache m_lerpedCache;
+  float m_channelGain = 1.f;              /**< Largest channel coefficient sent to backend (0 when out of range) */
+  bool m_virtual = false;                 /**< Inaudible; sample timeline advanced without decoding */
 
   VoiceState m_voxState = VoiceState::Dead; /**< Current high-level state of voice */
   bool m_sustained = false;                 /**< Sustain pedal pressed for this voice */
@@ -142,19 +189,18 @@ class Voice : public Entity {
   uint8_t m_pitchSweep1It = 0;    /**< Current iteration of PITCHSWEEP1 controller */
   uint8_t m_pitchSweep2It = 0;    /**< Current iteration of PITCHSWEEP2 controller */
 
-  std::queue<Panning> m_panningQueue;  /**< Queue of PANNING commands */
-  std::queue<Panning> m_spanningQueue; /**< Queue of SPANNING commands */
+  PanningQueue m_panningQueue;  /**< Queue of PANNING commands */
+  PanningQueue m_spanningQueue; /**< Queue of SPANNING commands */
 
-  float m_vibratoTime = -1.f;     /**< time since last VIBRATO command, -1 for no active vibrato */
+  Oscillator m_vibrato;           /**< vibrato triangle oscillator, inactive for no vibrato */
   int32_t m_vibratoLevel = 0;     /**< scale of vibrato effect (in cents) */
   int32_t m_vibratoModLevel = 0;  /**< scale of vibrato mod-wheel influence (in cents) */
-  float m_vibratoPeriod = 0.f;    /**< vibrato wave period-time, 0.f will disable vibrato */
   bool m_vibratoModWheel = false; /**< vibrato scaled with mod-wheel if set */
 
   float m_tremoloScale = 0.f;    /**< minimum volume factor produced via LFO */
   float m_tremoloModScale = 0.f; /**< minimum volume factor produced via LFO, scaled via mod wheel */
 
-  std::array<float, 2> m_lfoPeriods{};      /**< time-periods for LFO1 and LFO2 */
+  std::array<Oscillator, 2> m_lfos{};       /**< LFO1 and LFO2 oscillators */
   std::unique_ptr<int8_t[]> m_ctrlValsSelf; /**< Self-owned MIDI Controller values */
   int8_t* m_extCtrlVals = nullptr;          /**< MIDI Controller values (external storage) */
 
@@ -165,16 +211,24 @@ class Voice : public Entity {
   void _doKeyOff();
   void _macroKeyOff();
   void _macroSampleEnd();
-  void _procSamplePre(int16_t& samp);
+  void _advanceAmplitude(uint32_t samples);
+  bool _updateVirtual();
+  void _advanceVirtual(uint32_t samples);
+  void _procSamplesPre(int16_t* samps, uint32_t count);
   VolumeCache m_masterCache;
-  template <typename T>
-  T _procSampleMaster(double time, T samp);
   VolumeCache m_auxACache;
-  template <typename T>
-  T _procSampleAuxA(double time, T samp);
   VolumeCache m_auxBCache;
+  std::array<float, 3> m_busGainsStart = {}; /**< Master/AuxA/AuxB gains at start of current block */
+  std::array<float, 3> m_busGainsEnd = {};   /**< Master/AuxA/AuxB gains at end of current block */
+  bool m_busGainsValid = false;              /**< Bus gains computed for current block */
+  bool m_busGainsPrimed = false;             /**< m_busGainsEnd holds a previous block's gains */
+  double m_preSupplyTime = 0.0;              /**< Seconds in preSupplyAudio this pump cycle */
+  double m_supplyTime = 0.0;                 /**< Seconds in supplyAudio this pump cycle */
+  double m_routeTime = 0.0;                  /**< Seconds in routeAudio this pump cycle */
+  void _evaluateBusGains(std::array<float, 3>& gains);
+  void _prepareBusGains();
   template <typename T>
-  T _procSampleAuxB(double time, T samp);
+  void _routeAudio(size_t frames, int busId, const T* in, T* out);
   void _setTotalPitch(int32_t cents, bool slew);
   bool _isRecursivelyDead();
   void _bringOutYourDead();
@@ -182,9 +236,23 @@ class Voice : public Entity {
   ObjToken<Voice> _findVoice(int vid, ObjToken<Voice> thisPtr);
   std::unique_ptr<int8_t[]>& _ensureCtrlVals();
 
-  std::list<ObjToken<Voice>>::iterator _allocateVoice(double sampleRate, bool dynamicPitch);
+  std::list<ObjToken<Voice>>::iterator _allocateVoice(double sampleRate, bool dynamicPitch, uint8_t priority,
+                                                      uint8_t maxVoices, const void* limitTag);
   std::list<ObjToken<Voice>>::iterator _destroyVoice(std::list<ObjToken<Voice>>::iterator it);
 
+  bool _isStolen() const { return m_stealFade >= 0.f; }
+  void _steal();
+
+  /** Invoke `func` on this voice and all descendants that have not been destroyed */
+  template <typename Func>
+  void _visitVoices(Func&& func) {
+    if (m_destroyed)
+      return;
+    func(*this);
+    for (ObjToken<Voice>& vox : m_childVoices)
+      vox->_visitVoices(func);
+  }
+
   bool _loadSoundMacro(SoundMacroId id, const SoundMacro* macroData, int macroStep, double ticksPerSec, uint8_t midiKey,
                        uint8_t midiVel, uint8_t midiMod, bool pushPc = false);
   bool _loadKeymap(const Keymap* keymap, double ticksPerSec, uint8_t midiKey, uint8_t midiVel, uint8_t midiMod,
@@ -192,7 +260,8 @@ class Voice : public Entity {
   bool _loadLayer(const std::vector<LayerMapping>& layer, double ticksPerSec, uint8_t midiKey, uint8_t midiVel,
                   uint8_t midiMod, bool pushPc = false);
   ObjToken<Voice> _startChildMacro(ObjectId macroId, int macroStep, double ticksPerSec, uint8_t midiKey,
-                                   uint8_t midiVel, uint8_t midiMod, bool pushPc = false);
+                                   uint8_t midiVel, uint8_t midiMod, uint8_t priority, uint8_t maxVoices,
+                                   const void* limitTag, bool pushPc = false);
 
   std::array<float, 8> _panLaw(float frontPan, float backPan, float totalSpan) const;
   void _setPan(float pan);
@@ -202,6 +271,12 @@ class Voice : public Entity {
   void _notifyCtrlChange(uint8_t ctrl, int8_t val);
 
 public:
+  /** Voices are always created through these so the storage carries a VoicePool::SlotHeader */
+  static void* operator new(size_t sz);
+  static void* operator new(size_t sz, VoicePool& pool) noexcept;
+  static void operator delete(void* ptr);
+  static void operator delete(void* ptr, VoicePool& pool);
+
   ~Voice() override;
   Voice(Engine& engine, const AudioGroup& group, GroupId groupId, int vid, bool emitter, ObjToken<Studio> studio);
   Voice(Engine& engine, const AudioGroup& group, GroupId groupId, ObjectId oid, int vid, bool emitter,
@@ -233,8 +308,11 @@ public:
   /** Get max VoiceId of this voice and any contained children */
   int maxVid() const;
 
-  /** Allocate parallel macro and tie to voice for possible emitter influence */
-  ObjToken<Voice> startChildMacro(int8_t addNote, ObjectId macroId, int macroStep);
+  /** Allocate parallel macro and tie to voice for possible emitter influence.
+   *  At most `maxVoices` (0 for unlimited) children sharing `limitTag` play at once */
+  ObjToken<Voice> startChildMacro(int8_t addNote, ObjectId macroId, int macroStep,
+                                  uint8_t priority = DefaultVoicePriority, uint8_t maxVoices = 0,
+                                  const void* limitTag = nullptr);
 
   /** Load specified SoundMacro Object from within group into voice */
   bool loadMacroObject(SoundMacroId macroId, int macroStep, double ticksPerSec, uint8_t midiKey, uint8_t midiVel,
@@ -302,10 +380,10 @@ public:
   void setTremolo(float tremoloScale, float tremoloModScale);
 
   /** Setup LFO1 for voice */
-  void setLFO1Period(float period) { m_lfoPeriods[0] = period; }
+  void setLFO1Period(float period) { m_lfos[0].setPeriod(period); }
 
   /** Setup LFO2 for voice */
-  void setLFO2Period(float period) { m_lfoPeriods[1] = period; }
+  void setLFO2Period(float period) { m_lfos[1].setPeriod(period); }
 
   /** Setup pitch sweep controller 1 */
   void setPitchSweep1(uint8_t times, int16_t add);
@@ -383,6 +461,27 @@ public:
   /** Get count of all voices in hierarchy, including this one */
   size_t getTotalVoices() const;
 
+  /** Get stealing priority of voice */
+  uint8_t getPriority() const { return m_priority; }
+
+  /** Set stealing priority of voice; lower priorities are stolen first when polyphony is exhausted */
+  void setPriority(uint8_t prio) { m_priority = prio; }
+
+  /** Get current age counter of voice */
+  uint16_t getAgeCount() const { return uint16_t(m_ageCount); }
+
+  /** Set age counter of voice */
+  void setAgeCount(uint16_t count) { m_ageCount = count; }
+
+  /** Set time in milliseconds for the age counter to run down from 65535 to 0 */
+  void setAgeCountSpeed(uint32_t ms) { m_ageSpeed = ms ? 65535.f * 1000.f / float(ms) : 0.f; }
+
+  /** Whether voice is currently inaudible and skipping sample decode */
+  bool isVirtual() const { return m_virtual; }
+
+  /** Whether voice has been stolen and is fading out */
+  bool isStolen() const { return _isStolen(); }
+
   /** Get latest decoded sample index */
   uint32_t getSamplePos() const { return m_curSamplePos; }
 
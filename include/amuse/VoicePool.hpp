@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+
+#include "amuse/Common.hpp"
+#include "amuse/IBackendVoice.hpp"
+#include "amuse/SoundMacroState.hpp"
+
+namespace amuse {
+class Voice;
+
+/** Fixed-capacity arena backing Voice allocations for a single Engine.
+ *  Released voices return their slot to an intrusive free list instead of the heap, the list nodes
+ *  holding active/child voices are recycled by splicing and each slot keeps its backend voice for the
+ *  next occupant, so key-on does not touch the allocator. Allocations beyond capacity are refused. */
+class VoicePool : public IObj {
+public:
+  /** Bookkeeping stored immediately before every Voice, pooled or not */
+  struct SlotHeader {
+    VoicePool* m_pool = nullptr;                   /**< Owning pool; null for heap-backed voices */
+    SlotHeader* m_nextFree = nullptr;              /**< Intrusive free-list link while slot is unused */
+    SoundMacroState::PCStack m_pcSpare;            /**< Macro call-stack storage retained across voice lifetimes */
+    std::unique_ptr<IBackendVoice> m_backendSpare; /**< Backend voice released by the previous occupant */
+  };
+
+  static constexpr size_t SlotAlign = 16;
+  static constexpr size_t HeaderSize = (sizeof(SlotHeader) + SlotAlign - 1) & ~(SlotAlign - 1);
+  static constexpr size_t DefaultCapacity = 128;
+
+  static SlotHeader* HeaderOf(void* obj) {
+    return reinterpret_cast<SlotHeader*>(static_cast<unsigned char*>(obj) - HeaderSize);
+  }
+
+private:
+  struct StorageDeleter {
+    void operator()(unsigned char* ptr) const;
+  };
+
+  size_t m_capacity;
+  size_t m_slotStride;
+  std::unique_ptr<unsigned char[], StorageDeleter> m_storage;
+  std::atomic<SlotHeader*> m_freeHead = {nullptr};
+  std::atomic_size_t m_numInUse = {0};
+  size_t m_peakInUse = 0;
+  size_t m_numRefused = 0;
+  std::list<ObjToken<Voice>> m_freeNodes; /**< Spare list nodes for active/child voice lists */
+
+  void _free(SlotHeader* header);
+
+public:
+  explicit VoicePool(size_t capacity);
+  ~VoicePool() override;
+
+  VoicePool(const VoicePool&) = delete;
+  VoicePool& operator=(const VoicePool&) = delete;
+
+  /** Obtain storage for one Voice, or null when every slot is in use;
+   *  must be called from the thread driving the Engine */
+  void* allocate(size_t sz);
+
+  /** Obtain heap storage with a SlotHeader, for voices created outside (or beyond) a pool */
+  static void* AllocateHeap(size_t sz);
+
+  /** Return Voice storage obtained from allocate() or AllocateHeap(); safe from any thread */
+  static void Deallocate(void* obj);
+
+  /** Append `vox` to `list` using a recycled node when one is available */
+  std::list<ObjToken<Voice>>::iterator linkVoice(std::list<ObjToken<Voice>>& list, ObjToken<Voice> vox);
+
+  /** Release token at `it` and recycle its node; returns iterator following `it` */
+  std::list<ObjToken<Voice>>::iterator unlinkVoice(std::list<ObjToken<Voice>>& list,
+                                                   std::list<ObjToken<Voice>>::iterator it);
+
+  /** Release every token in `list` and recycle all of its nodes */
+  void unlinkAll(std::list<ObjToken<Voice>>& list);
+
+  size_t getCapacity() const { return m_capacity; }
+  size_t getNumInUse() const { return m_numInUse.load(std::memory_order_relaxed); }
+  size_t getPeakInUse() const { return m_peakInUse; }
+
+  /** Count of voices refused because every slot was in use */
+  size_t getNumRefused() const { return m_numRefused; }
+};
+
+} // namespace amuse
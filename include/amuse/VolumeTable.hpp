@@ -1,6 +1,12 @@
 #pragma once
 
+#include <cstddef>
+
 namespace amuse {
 float LookupVolume(float vol);
 float LookupDLSVolume(float vol);
+
+/** In-place block variants of the above; results are bit-identical to per-sample lookups */
+void LookupVolumeBlock(float* vols, size_t count);
+void LookupDLSVolumeBlock(float* vols, size_t count);
 } // namespace amuse
@@ -5,17 +5,29 @@
 #include "amuse/AudioGroupPool.hpp"
 #include "amuse/AudioGroupProject.hpp"
 #include "amuse/AudioGroupSampleDirectory.hpp"
+#include "amuse/CommandQueue.hpp"
 #include "amuse/ContainerRegistry.hpp"
 #include "amuse/EffectChorus.hpp"
+#include "amuse/EffectConvolution.hpp"
 #include "amuse/EffectDelay.hpp"
 #include "amuse/EffectReverb.hpp"
 #include "amuse/Emitter.hpp"
 #include "amuse/Engine.hpp"
+#include "amuse/EngineStats.hpp"
 #include "amuse/Envelope.hpp"
+#include "amuse/FFT.hpp"
 #include "amuse/Listener.hpp"
+#include "amuse/MIDIEventQueue.hpp"
+#include "amuse/OfflineBackend.hpp"
+#include "amuse/Oscillator.hpp"
+#include "amuse/RenderPool.hpp"
+#include "amuse/Resampler.hpp"
+#include "amuse/SampleCache.hpp"
+#include "amuse/SampleFileWatcher.hpp"
 #include "amuse/Sequencer.hpp"
 #include "amuse/SoundMacroState.hpp"
 #include "amuse/SongConverter.hpp"
 #include "amuse/SongState.hpp"
 #include "amuse/Submix.hpp"
 #include "amuse/Voice.hpp"
+#include "amuse/VoicePool.hpp"
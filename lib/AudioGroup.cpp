@@ -18,6 +18,14 @@ void AudioGroup::assign(const AudioGroupData& data) {
   m_proj = AudioGroupProject::CreateAudioGroupProject(data);
   m_sdir = AudioGroupSampleDirectory::CreateAudioGroupSampleDirectory(data);
   m_samp = data.getSamp();
+  m_sampleWatcher.reset();
+
+  /* Index DSPADPCM predictor state up-front so offset starts never decode from the beginning */
+  for (auto& p : m_sdir.m_entries) {
+    SampleEntryData& ent = *p.second->m_data;
+    if (m_samp && ent.isFormatDSP())
+      ent.buildDSPSeekIndex(m_samp + ent.m_sampleOff);
+  }
 }
 void AudioGroup::assign(std::string_view groupPath) {
   /* Reverse order when loading intermediates */
@@ -26,6 +34,7 @@ void AudioGroup::assign(std::string_view groupPath) {
   m_pool = AudioGroupPool::CreateAudioGroupPool(groupPath);
   m_proj = AudioGroupProject::CreateAudioGroupProject(groupPath);
   m_samp = nullptr;
+  _watchSampleFiles();
 }
 void AudioGroup::assign(const AudioGroup& data, std::string_view groupPath) {
   /* Reverse order when loading intermediates */
@@ -34,6 +43,17 @@ void AudioGroup::assign(const AudioGroup& data, std::string_view groupPath) {
   m_pool = AudioGroupPool::CreateAudioGroupPool(groupPath);
   m_proj = AudioGroupProject::CreateAudioGroupProject(data.getProj());
   m_samp = nullptr;
+  _watchSampleFiles();
+}
+
+void AudioGroup::_watchSampleFiles() {
+  m_sampleWatcher = std::make_unique<SampleFileWatcher>(m_groupPath);
+  for (auto& p : m_sdir.m_entries) {
+    if (!p.second->m_data->m_looseData)
+      continue;
+    m_sampleWatcher->watchSample(SampleId::CurNameDB->resolveNameFromId(p.first), p.second);
+    p.second->m_looseDirty.store(false);
+  }
 }
 
 const SampleEntry* AudioGroup::getSample(SampleId sfxId) const {
@@ -50,8 +70,13 @@ std::string AudioGroup::getSampleBasePath(SampleId sfxId) const {
 std::pair<ObjToken<SampleEntryData>, const unsigned char*> AudioGroup::getSampleData(SampleId sfxId,
                                                                                      const SampleEntry* sample) const {
   if (sample->m_data->m_looseData) {
-    std::string basePath = getSampleBasePath(sfxId);
-    const_cast<SampleEntry*>(sample)->loadLooseData(basePath);
+    /* Hit the filesystem only when the watcher has flagged a change; registration happens on the
+     * threads that load, add and rename samples */
+    SampleEntry& mutSample = const_cast<SampleEntry&>(*sample);
+    if (mutSample.m_looseDirty.exchange(false, std::memory_order_acq_rel)) {
+      std::string basePath = getSampleBasePath(sfxId);
+      mutSample.loadLooseData(basePath);
+    }
     return {sample->m_data, sample->m_data->m_looseData.get()};
   }
   return {sample->m_data, m_samp + sample->m_data->m_sampleOff};
@@ -88,15 +113,33 @@ void AudioGroup::makeCompressedVersion(SampleId sfxId, const SampleEntry* sample
 
 void AudioGroupDatabase::renameSample(SampleId id, std::string_view str) {
   std::string oldBasePath = getSampleBasePath(id);
+  if (m_sampleWatcher)
+    m_sampleWatcher->unwatchSample(SampleId::CurNameDB->resolveNameFromId(id));
   SampleId::CurNameDB->rename(id, str);
   std::string newBasePath = getSampleBasePath(id);
   Rename((oldBasePath + ".wav").c_str(), (newBasePath + ".wav").c_str());
   Rename((oldBasePath + ".dsp").c_str(), (newBasePath + ".dsp").c_str());
   Rename((oldBasePath + ".vadpcm").c_str(), (newBasePath + ".vadpcm").c_str());
+
+  auto search = m_sdir.sampleEntries().find(id);
+  if (m_sampleWatcher && search != m_sdir.sampleEntries().end())
+    m_sampleWatcher->watchSample(str, search->second);
+}
+
+void AudioGroupDatabase::reloadSampleData() {
+  m_sdir.reloadSampleData(m_groupPath);
+  if (!m_sampleWatcher)
+    return;
+  for (auto& p : m_sdir.sampleEntries()) {
+    if (p.second->m_data->m_looseData)
+      m_sampleWatcher->watchSample(SampleId::CurNameDB->resolveNameFromId(p.first), p.second);
+  }
 }
 
 void AudioGroupDatabase::deleteSample(SampleId id) {
   std::string basePath = getSampleBasePath(id);
+  if (m_sampleWatcher)
+    m_sampleWatcher->unwatchSample(SampleId::CurNameDB->resolveNameFromId(id));
   Unlink((basePath + ".wav").c_str());
   Unlink((basePath + ".dsp").c_str());
   Unlink((basePath + ".vadpcm").c_str());
@@ -83,6 +83,7 @@ AudioGroupSampleDirectory::AudioGroupSampleDirectory(athena::io::IStreamReader&
   for (auto& p : m_entries) {
     memcpy(&p.second->m_data->m_ADPCMParms, sampData + p.second->m_data->m_sampleOff, sizeof(ADPCMParms::VADPCMParms));
     p.second->m_data->m_ADPCMParms.swapBigVADPCM();
+    p.second->m_data->buildVADPCMPredictor();
   }
 }
 
@@ -137,21 +138,52 @@ static uint32_t DSPNibbleToSample(uint32_t nibble) {
   return ret;
 }
 
+void AudioGroupSampleDirectory::EntryData::buildDSPSeekIndex(const unsigned char* data) {
+  const uint32_t numFrames = (getNumSamples() + 13) / 14;
+  m_dspSeekIndex.clear();
+  m_dspSeekIndex.reserve(numFrames / DSPSeekInterval + 1);
+
+  int16_t prev1 = 0;
+  int16_t prev2 = 0;
+  for (uint32_t b = 0; b < numFrames; ++b) {
+    if (b % DSPSeekInterval == 0)
+      m_dspSeekIndex.push_back({prev1, prev2});
+    DSPDecompressFrameStateOnly(data + 8 * b, m_ADPCMParms.dsp.m_coefs, &prev1, &prev2, 14);
+  }
+}
+
+void AudioGroupSampleDirectory::EntryData::seekDSPState(const unsigned char* data, uint32_t sample, int16_t* prev1,
+                                                        int16_t* prev2) const {
+  const uint32_t block = sample / 14;
+  const uint32_t rem = sample % 14;
+  uint32_t b = 0;
+  *prev1 = 0;
+  *prev2 = 0;
+
+  /* Start from the nearest seek point at or before the target frame */
+  if (!m_dspSeekIndex.empty()) {
+    const uint32_t point = std::min(block / DSPSeekInterval, uint32_t(m_dspSeekIndex.size() - 1));
+    *prev1 = m_dspSeekIndex[point].m_hist1;
+    *prev2 = m_dspSeekIndex[point].m_hist2;
+    b = point * DSPSeekInterval;
+  }
+
+  for (; b < block; ++b)
+    DSPDecompressFrameStateOnly(data + 8 * b, m_ADPCMParms.dsp.m_coefs, prev1, prev2, 14);
+  if (rem)
+    DSPDecompressFrameStateOnly(data + 8 * block, m_ADPCMParms.dsp.m_coefs, prev1, prev2, rem);
+}
+
 void AudioGroupSampleDirectory::EntryData::setLoopStartSample(atUint32 sample) {
   _setLoopStartSample(sample);
 
   if (m_looseData && isFormatDSP()) {
-    uint32_t block = m_loopStartSample / 14;
-    uint32_t rem = m_loopStartSample % 14;
-    int16_t prev1 = 0;
-    int16_t prev2 = 0;
-    for (uint32_t b = 0; b < block; ++b)
-      DSPDecompressFrameStateOnly(m_looseData.get() + 8 * b, m_ADPCMParms.dsp.m_coefs, &prev1, &prev2, 14);
-    if (rem)
-      DSPDecompressFrameStateOnly(m_looseData.get() + 8 * block, m_ADPCMParms.dsp.m_coefs, &prev1, &prev2, rem);
+    int16_t prev1;
+    int16_t prev2;
+    seekDSPState(m_looseData.get(), m_loopStartSample, &prev1, &prev2);
     m_ADPCMParms.dsp.m_hist1 = prev1;
     m_ADPCMParms.dsp.m_hist2 = prev2;
-    m_ADPCMParms.dsp.m_lps = m_looseData[8 * block];
+    m_ADPCMParms.dsp.m_lps = m_looseData[8 * (m_loopStartSample / 14)];
   }
 }
 
@@ -178,6 +210,7 @@ void AudioGroupSampleDirectory::EntryData::loadLooseDSP(std::string_view dspPath
     uint32_t dataLen = (header.x4_num_nibbles + 1) / 2;
     m_looseData.reset(new uint8_t[dataLen]);
     r.readUBytesToBuf(m_looseData.get(), dataLen);
+    buildDSPSeekIndex(m_looseData.get());
   }
 }
 
@@ -199,6 +232,7 @@ void AudioGroupSampleDirectory::EntryData::loadLooseVADPCM(std::string_view vadp
 
     memcpy(&m_ADPCMParms, m_looseData.get(), 256);
     m_ADPCMParms.swapBigVADPCM();
+    buildVADPCMPredictor();
   }
 }
 
@@ -626,16 +660,15 @@ void AudioGroupSampleDirectory::_extractWAV(SampleId id, const EntryData& ent, s
   atUint64 dataLen;
   if (fmt == SampleFormat::DSP || fmt == SampleFormat::DSP_DRUM) {
     uint32_t remSamples = numSamples;
-    uint32_t numFrames = (remSamples + 13) / 14;
     const unsigned char* cur = samp;
     int16_t prev1 = ent.m_ADPCMParms.dsp.m_hist1;
     int16_t prev2 = ent.m_ADPCMParms.dsp.m_hist2;
-    for (uint32_t i = 0; i < numFrames; ++i) {
-      int16_t decomp[14] = {};
-      unsigned thisSamples = std::min(remSamples, 14u);
-      DSPDecompressFrame(decomp, cur, ent.m_ADPCMParms.dsp.m_coefs, &prev1, &prev2, thisSamples);
+    while (remSamples) {
+      int16_t decomp[14 * 256];
+      unsigned thisSamples = std::min(remSamples, 14u * 256u);
+      DSPDecompressFrames(decomp, cur, ent.m_ADPCMParms.dsp.m_coefs, &prev1, &prev2, thisSamples);
       remSamples -= thisSamples;
-      cur += 8;
+      cur += 8 * 256;
       w.writeBytes(decomp, thisSamples * 2);
     }
 
@@ -652,7 +685,10 @@ void AudioGroupSampleDirectory::_extractWAV(SampleId id, const EntryData& ent, s
     for (uint32_t i = 0; i < numFrames; ++i) {
       int16_t decomp[64] = {};
       unsigned thisSamples = std::min(remSamples, 64u);
-      N64MusyXDecompressFrame(decomp, cur, ent.m_ADPCMParms.vadpcm.m_coefs, thisSamples);
+      if (ent.m_vadpcmPredictor)
+        N64MusyXDecompressFrame(decomp, cur, *ent.m_vadpcmPredictor, thisSamples);
+      else
+        N64MusyXDecompressFrame(decomp, cur, ent.m_ADPCMParms.vadpcm.m_coefs, thisSamples);
       remSamples -= thisSamples;
       cur += 40;
       w.writeBytes(decomp, thisSamples * 2);
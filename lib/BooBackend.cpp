@@ -7,32 +7,43 @@
 namespace amuse {
 
 void BooBackendVoice::VoiceCallback::preSupplyAudio(boo::IAudioVoice&, double dt) {
-  m_parent.m_clientVox.preSupplyAudio(dt);
+  if (m_parent.m_clientVox)
+    m_parent.m_clientVox->preSupplyAudio(dt);
 }
 
 size_t BooBackendVoice::VoiceCallback::supplyAudio(boo::IAudioVoice&, size_t frames, int16_t* data) {
-  return m_parent.m_clientVox.supplyAudio(frames, data);
+  return m_parent.m_clientVox ? m_parent.m_clientVox->supplyAudio(frames, data) : 0;
 }
 
 void BooBackendVoice::VoiceCallback::routeAudio(size_t frames, size_t channels, double dt, int busId, int16_t* in,
                                                 int16_t* out) {
-  m_parent.m_clientVox.routeAudio(frames, dt, busId, in, out);
+  if (m_parent.m_clientVox)
+    m_parent.m_clientVox->routeAudio(frames, dt, busId, in, out);
 }
 
 void BooBackendVoice::VoiceCallback::routeAudio(size_t frames, size_t channels, double dt, int busId, int32_t* in,
                                                 int32_t* out) {
-  m_parent.m_clientVox.routeAudio(frames, dt, busId, in, out);
+  if (m_parent.m_clientVox)
+    m_parent.m_clientVox->routeAudio(frames, dt, busId, in, out);
 }
 
 void BooBackendVoice::VoiceCallback::routeAudio(size_t frames, size_t channels, double dt, int busId, float* in,
                                                 float* out) {
-  m_parent.m_clientVox.routeAudio(frames, dt, busId, in, out);
+  if (m_parent.m_clientVox)
+    m_parent.m_clientVox->routeAudio(frames, dt, busId, in, out);
 }
 
 BooBackendVoice::BooBackendVoice(boo::IAudioVoiceEngine& engine, Voice& clientVox, double sampleRate, bool dynamicPitch)
-: m_clientVox(clientVox), m_cb(*this), m_booVoice(engine.allocateNewMonoVoice(sampleRate, &m_cb, dynamicPitch)) {}
-
-void BooBackendVoice::resetSampleRate(double sampleRate) { m_booVoice->resetSampleRate(sampleRate); }
+: m_clientVox(&clientVox)
+, m_sampleRate(sampleRate)
+, m_dynamicPitch(dynamicPitch)
+, m_cb(*this)
+, m_booVoice(engine.allocateNewMonoVoice(sampleRate, &m_cb, dynamicPitch)) {}
+
+void BooBackendVoice::resetSampleRate(double sampleRate) {
+  m_sampleRate = sampleRate;
+  m_booVoice->resetSampleRate(sampleRate);
+}
 
 void BooBackendVoice::resetChannelLevels() { m_booVoice->resetChannelLevels(); }
 
@@ -84,6 +95,7 @@ BooBackendMIDIReader::~BooBackendMIDIReader() {}
 
 BooBackendMIDIReader::BooBackendMIDIReader(Engine& engine, bool useLock)
 : m_engine(engine), m_decoder(*this), m_useLock(useLock) {
+  m_pumpBuf.reserve(m_queue.maxMessageSize());
   BooBackendVoiceAllocator& voxAlloc = static_cast<BooBackendVoiceAllocator&>(engine.getBackend());
   auto devices = voxAlloc.m_booEngine.enumerateMIDIInputs();
   for (const auto& dev : devices) {
@@ -127,7 +139,7 @@ void BooBackendMIDIReader::_MIDIReceive(std::vector<uint8_t>&& bytes, double tim
   std::unique_lock<std::mutex> lk(m_midiMutex, std::defer_lock_t{});
   if (m_useLock)
     lk.lock();
-  m_queue.emplace_back(time, std::move(bytes));
+  m_queue.push(time, bytes.data(), bytes.size());
 #if 0
     openlog("LogIt", (LOG_CONS|LOG_PERROR|LOG_PID), LOG_DAEMON);
     syslog(LOG_EMERG, "MIDI receive %f\n", time);
@@ -136,39 +148,32 @@ void BooBackendMIDIReader::_MIDIReceive(std::vector<uint8_t>&& bytes, double tim
 }
 
 void BooBackendMIDIReader::pumpReader(double dt) {
+  const double interval = dt;
   dt += 0.001; /* Add 1ms to ensure consumer keeps up with producer */
 
-  std::unique_lock<std::mutex> lk(m_midiMutex, std::defer_lock_t{});
-  if (m_useLock)
-    lk.lock();
-  if (m_queue.empty())
+  const MIDIEvent* ev = m_queue.front();
+  if (!ev)
     return;
 
-  /* Determine range of buffer updates within this period */
-  auto periodEnd = m_queue.cbegin();
-  double startPt = m_queue.front().first;
-  for (; periodEnd != m_queue.cend(); ++periodEnd) {
-    double delta = periodEnd->first - startPt;
-    if (delta > dt)
-      break;
-  }
-
-  if (m_queue.cbegin() == periodEnd)
-    return;
-
-  /* Dispatch buffers */
-  for (auto it = m_queue.begin(); it != periodEnd;) {
+  /* Dispatch buffers within this period */
+  const double startPt = ev->m_time;
+  for (; ev && ev->m_time - startPt <= dt; ev = m_queue.front()) {
+    /* Keep the spacing of events within the period so voices start sample-accurately */
+    const double eventTime = ev->m_time;
+    m_pumpBuf.resize(ev->m_len);
+    m_queue.copyBytes(*ev, m_pumpBuf.data());
+    m_queue.pop();
 #if 0
         char str[64];
-        sprintf(str, "MIDI %zu %f ", it->second.size(), it->first);
-        for (uint8_t byte : it->second)
+        sprintf(str, "MIDI %zu %f ", m_pumpBuf.size(), eventTime);
+        for (uint8_t byte : m_pumpBuf)
             sprintf(str + strlen(str), "%02X ", byte);
         openlog("LogIt", (LOG_CONS|LOG_PERROR|LOG_PID), LOG_DAEMON);
         syslog(LOG_EMERG, "%s\n", str);
         closelog();
 #endif
-    m_decoder.receiveBytes(it->second.cbegin(), it->second.cend());
-    it = m_queue.erase(it);
+    m_engine.setEventOffset(std::min(eventTime - startPt, interval));
+    m_decoder.receiveBytes(m_pumpBuf.cbegin(), m_pumpBuf.cend());
   }
 }
 
@@ -256,6 +261,28 @@ std::unique_ptr<IBackendVoice> BooBackendVoiceAllocator::allocateVoice(Voice& cl
   return std::make_unique<BooBackendVoice>(m_booEngine, clientVox, sampleRate, dynamicPitch);
 }
 
+bool BooBackendVoiceAllocator::releaseVoice(IBackendVoice& voice) {
+  auto& vox = static_cast<BooBackendVoice&>(voice);
+  vox.stop();
+  vox.m_clientVox = nullptr;
+  return true;
+}
+
+bool BooBackendVoiceAllocator::reuseVoice(IBackendVoice& voice, Voice& clientVox, double sampleRate,
+                                          bool dynamicPitch) {
+  /* Pitch mode is fixed when boo creates the voice */
+  auto& vox = static_cast<BooBackendVoice&>(voice);
+  if (vox.m_dynamicPitch != dynamicPitch)
+    return false;
+  vox.m_clientVox = &clientVox;
+  vox.resetChannelLevels();
+  if (dynamicPitch)
+    vox.setPitchRatio(1.0, false);
+  if (vox.m_sampleRate != sampleRate)
+    vox.resetSampleRate(sampleRate);
+  return true;
+}
+
 std::unique_ptr<IBackendSubmix> BooBackendVoiceAllocator::allocateSubmix(Submix& clientSmx, bool mainOut, int busId) {
   return std::make_unique<BooBackendSubmix>(m_booEngine, clientSmx, mainOut, busId);
 }
@@ -0,0 +1,126 @@
+#include "amuse/CommandQueue.hpp"
+
+#include "amuse/Engine.hpp"
+#include "amuse/Sequencer.hpp"
+#include "amuse/Studio.hpp"
+#include "amuse/Voice.hpp"
+
+namespace amuse {
+
+static size_t NextPowerOfTwo(size_t val) {
+  size_t ret = 2;
+  while (ret < val)
+    ret <<= 1;
+  return ret;
+}
+
+CommandQueue::CommandQueue(size_t capacity)
+: m_slots(std::make_unique<Slot[]>(NextPowerOfTwo(capacity)))
+, m_mask(NextPowerOfTwo(capacity) - 1)
+, m_handles(std::make_unique<HandleSlot[]>(NextPowerOfTwo(capacity))) {
+  for (size_t i = 0; i <= m_mask; ++i)
+    m_slots[i].m_seq.store(i, std::memory_order_relaxed);
+}
+
+CommandQueue::~CommandQueue() {
+  /* Release captures of commands that never ran */
+  for (;; ++m_dequeuePos) {
+    Slot& slot = m_slots[m_dequeuePos & m_mask];
+    if (slot.m_seq.load(std::memory_order_acquire) != m_dequeuePos + 1)
+      break;
+    slot.m_op(slot.m_storage, nullptr);
+  }
+}
+
+CommandQueue::Slot* CommandQueue::_claimSlot() {
+  /* Bounded MPMC ring (Vyukov); each slot's sequence tells producers whether it is free for this lap */
+  size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+  for (;;) {
+    Slot& slot = m_slots[pos & m_mask];
+    const size_t seq = slot.m_seq.load(std::memory_order_acquire);
+    const auto diff = intptr_t(seq) - intptr_t(pos);
+    if (diff == 0) {
+      if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        return &slot;
+    } else if (diff < 0) {
+      return nullptr;
+    } else {
+      pos = m_enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+CommandQueue::HandleSlot* CommandQueue::_freeHandle() {
+  for (size_t i = 0; i <= m_mask; ++i)
+    if (!m_handles[i].m_entity)
+      return &m_handles[i];
+  return nullptr;
+}
+
+Entity* CommandQueue::_lookupHandle(uint32_t handle, uint32_t generation) const {
+  const HandleSlot& slot = m_handles[handle];
+  if (slot.m_generation != generation || !slot.m_entity || slot.m_entity->isDestroyed())
+    return nullptr;
+  return slot.m_entity.get();
+}
+
+void CommandQueue::_releaseHandles() {
+  /* Free handles whose entity died or whose future nobody else references anymore.
+   * Dropping the last entity reference here keeps its teardown on the mixing thread */
+  for (size_t i = 0; i <= m_mask; ++i) {
+    HandleSlot& slot = m_handles[i];
+    if (slot.m_entity && (slot.m_entity->isDestroyed() || slot.m_future->refCount() == 1)) {
+      slot.m_future.reset();
+      slot.m_entity.reset();
+      ++slot.m_generation;
+    }
+  }
+}
+
+void CommandQueue::drain(Engine& engine) {
+  _releaseHandles();
+
+  /* Stop at the first slot still being written, preserving posting order; commands posted
+   * while draining wait for the next interval so a busy producer cannot stall the mixer */
+  for (size_t count = 0; count <= m_mask; ++count) {
+    Slot& slot = m_slots[m_dequeuePos & m_mask];
+    if (slot.m_seq.load(std::memory_order_acquire) != m_dequeuePos + 1)
+      break;
+    slot.m_op(slot.m_storage, &engine);
+    slot.m_seq.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+    ++m_dequeuePos;
+  }
+}
+
+ObjToken<VoiceFuture> CommandQueue::fxStart(SFXId sfxId, float vol, float pan, ObjToken<Studio> smx) {
+  return postFuture<Voice>([sfxId, vol, pan, smx = std::move(smx)](Engine& engine) {
+    return smx ? engine.fxStart(sfxId, vol, pan, smx) : engine.fxStart(sfxId, vol, pan);
+  });
+}
+
+ObjToken<SequencerFuture> CommandQueue::seqPlay(GroupId groupId, SongId songId, const unsigned char* arrData,
+                                                bool loop, ObjToken<Studio> smx) {
+  return postFuture<Sequencer>([groupId, songId, arrData, loop, smx = std::move(smx)](Engine& engine) {
+    return smx ? engine.seqPlay(groupId, songId, arrData, loop, smx) : engine.seqPlay(groupId, songId, arrData, loop);
+  });
+}
+
+bool CommandQueue::setVolume(float vol) {
+  return post([vol](Engine& engine) { engine.setVolume(vol); });
+}
+
+bool CommandQueue::keyOff(ObjToken<VoiceFuture> voice) {
+  return post([this, voice = std::move(voice)](Engine&) {
+    if (Voice* vox = resolve(voice))
+      vox->keyOff();
+  });
+}
+
+bool CommandQueue::stopSong(ObjToken<SequencerFuture> seq, float fadeTime, bool now) {
+  return post([this, seq = std::move(seq), fadeTime, now](Engine&) {
+    if (Sequencer* sequencer = resolve(seq))
+      sequencer->stopSong(fadeTime, now);
+  });
+}
+
+} // namespace amuse
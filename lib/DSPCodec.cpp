@@ -10,6 +10,17 @@
 #include "switch_math.hpp"
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DSP_X86 1
+#include <tmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON)
+#define DSP_NEON 1
+#include <arm_neon.h>
+#endif
+
 #undef min
 #undef max
 
@@ -154,6 +165,204 @@ unsigned DSPDecompressFrameRangedStateOnly(const uint8_t* in, const int16_t coef
   return ret;
 }
 
+#pragma mark Batch Decoder
+
+/* The batch decoder splits each frame into a vectorizable residual stage
+ * (nibble unpack, sign extension, exponent scale) and a scalar IIR stage
+ * that keeps predictor history in registers. Output is bit-identical to
+ * DSPDecompressFrame. */
+
+#if defined(__GNUC__)
+#define DSP_TARGET(isa) __attribute__((target(isa)))
+#define DSP_FORCEINLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define DSP_TARGET(isa)
+#define DSP_FORCEINLINE __forceinline
+#else
+#define DSP_TARGET(isa)
+#define DSP_FORCEINLINE inline
+#endif
+
+/** Computes `(nibble << exp << 11) + 1024` for all 14 samples of a frame into `res` */
+using DSPResidualFunc = void (*)(int32_t res[16], const uint8_t* in);
+
+#if !DSP_X86 && !DSP_NEON
+static void DSPResidualsGeneric(int32_t res[16], const uint8_t* in) {
+  const uint8_t exp = in[0] & 0xf;
+  for (unsigned s = 0; s < 14; ++s) {
+    int32_t sampleData = (s & 1) ? NibbleToInt[(in[s / 2 + 1]) & 0xf] : NibbleToInt[(in[s / 2 + 1] >> 4) & 0xf];
+    sampleData <<= exp;
+    sampleData <<= 11;
+    res[s] = sampleData + 1024;
+  }
+}
+#endif
+
+#if DSP_X86
+/* Widens 16 sign-extended nibbles held in int16 lanes and applies the frame scale */
+static DSP_FORCEINLINE void DSPStoreResiduals(int32_t res[16], __m128i lo16, __m128i hi16, uint8_t exp) {
+  const __m128i shift = _mm_cvtsi32_si128(exp + 11);
+  const __m128i bias = _mm_set1_epi32(1024);
+  const __m128i l0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo16, lo16), 16);
+  const __m128i l1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo16, lo16), 16);
+  const __m128i h0 = _mm_srai_epi32(_mm_unpacklo_epi16(hi16, hi16), 16);
+  const __m128i h1 = _mm_srai_epi32(_mm_unpackhi_epi16(hi16, hi16), 16);
+  _mm_store_si128(reinterpret_cast<__m128i*>(res), _mm_add_epi32(_mm_sll_epi32(l0, shift), bias));
+  _mm_store_si128(reinterpret_cast<__m128i*>(res + 4), _mm_add_epi32(_mm_sll_epi32(l1, shift), bias));
+  _mm_store_si128(reinterpret_cast<__m128i*>(res + 8), _mm_add_epi32(_mm_sll_epi32(h0, shift), bias));
+  _mm_store_si128(reinterpret_cast<__m128i*>(res + 12), _mm_add_epi32(_mm_sll_epi32(h1, shift), bias));
+}
+
+static DSP_FORCEINLINE void DSPResidualsSSE2(int32_t res[16], const uint8_t* in) {
+  /* Bytes 1-7 hold the nibbles; interleave high and low halves into sample order */
+  const __m128i bytes = _mm_srli_si128(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in)), 1);
+  const __m128i mask = _mm_set1_epi8(0xf);
+  const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+  const __m128i lo = _mm_and_si128(bytes, mask);
+  __m128i nibbles = _mm_unpacklo_epi8(hi, lo);
+
+  /* Sign-extend 4-bit values to 16 bits */
+  const __m128i eight = _mm_set1_epi8(8);
+  nibbles = _mm_sub_epi8(_mm_xor_si128(nibbles, eight), eight);
+  const __m128i lo16 = _mm_srai_epi16(_mm_unpacklo_epi8(nibbles, nibbles), 8);
+  const __m128i hi16 = _mm_srai_epi16(_mm_unpackhi_epi8(nibbles, nibbles), 8);
+
+  DSPStoreResiduals(res, lo16, hi16, in[0] & 0xf);
+}
+
+DSP_TARGET("ssse3") static inline void DSPResidualsSSSE3(int32_t res[16], const uint8_t* in) {
+  /* Place each nibble's source byte in the high byte of an int16 lane; odd lanes
+   * are shifted up a further 4 bits so every nibble lands in the top of its lane */
+  const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in));
+  const __m128i spread = _mm_setr_epi8(-1, 1, -1, 1, -1, 2, -1, 2, -1, 3, -1, 3, -1, 4, -1, 4);
+  const __m128i spreadHi = _mm_setr_epi8(-1, 5, -1, 5, -1, 6, -1, 6, -1, 7, -1, 7, -1, -1, -1, -1);
+  const __m128i nibbleShift = _mm_setr_epi16(1, 16, 1, 16, 1, 16, 1, 16);
+  const __m128i lo16 = _mm_srai_epi16(_mm_mullo_epi16(_mm_shuffle_epi8(bytes, spread), nibbleShift), 12);
+  const __m128i hi16 = _mm_srai_epi16(_mm_mullo_epi16(_mm_shuffle_epi8(bytes, spreadHi), nibbleShift), 12);
+
+  DSPStoreResiduals(res, lo16, hi16, in[0] & 0xf);
+}
+#endif
+
+#if DSP_NEON
+static DSP_FORCEINLINE void DSPResidualsNEON(int32_t res[16], const uint8_t* in) {
+  /* Rotate bytes 1-7 down and interleave high and low halves into sample order */
+  const uint8x8_t bytes = vext_u8(vld1_u8(in), vld1_u8(in), 1);
+  const uint8x8x2_t zipped = vzip_u8(vshr_n_u8(bytes, 4), vand_u8(bytes, vdup_n_u8(0xf)));
+
+  /* Sign-extend 4-bit values to 16 bits */
+  const int8x8_t eight = vdup_n_s8(8);
+  const int16x8_t lo16 = vmovl_s8(vsub_s8(veor_s8(vreinterpret_s8_u8(zipped.val[0]), eight), eight));
+  const int16x8_t hi16 = vmovl_s8(vsub_s8(veor_s8(vreinterpret_s8_u8(zipped.val[1]), eight), eight));
+
+  const int32x4_t shift = vdupq_n_s32((in[0] & 0xf) + 11);
+  const int32x4_t bias = vdupq_n_s32(1024);
+  vst1q_s32(res, vaddq_s32(vshlq_s32(vmovl_s16(vget_low_s16(lo16)), shift), bias));
+  vst1q_s32(res + 4, vaddq_s32(vshlq_s32(vmovl_s16(vget_high_s16(lo16)), shift), bias));
+  vst1q_s32(res + 8, vaddq_s32(vshlq_s32(vmovl_s16(vget_low_s16(hi16)), shift), bias));
+  vst1q_s32(res + 12, vaddq_s32(vshlq_s32(vmovl_s16(vget_high_s16(hi16)), shift), bias));
+}
+#endif
+
+/** Shared driver; inlined into each ISA entry point so the residual stage inlines too */
+template <DSPResidualFunc Residuals>
+static DSP_FORCEINLINE unsigned DSPDecompressFramesImp(int16_t* out, const uint8_t* in, const int16_t coefs[8][2],
+                                                       int16_t* prev1, int16_t* prev2, unsigned firstSample,
+                                                       unsigned lastSample) {
+  int32_t p1 = *prev1;
+  int32_t p2 = *prev2;
+  unsigned ret = 0;
+  while (firstSample < lastSample) {
+    alignas(16) int32_t res[16];
+    Residuals(res, in);
+
+    const uint8_t cIdx = (in[0] >> 4) & 0xf;
+    const int32_t factor1 = coefs[cIdx][0];
+    const int32_t factor2 = coefs[cIdx][1];
+    const unsigned end = std::min(lastSample, 14u);
+    for (unsigned s = firstSample; s < end; ++s) {
+      const int32_t sampleData = DSPSampClamp((res[s] + (factor1 * p1 + factor2 * p2)) >> 11);
+      out[ret++] = sampleData;
+      p2 = p1;
+      p1 = sampleData;
+    }
+
+    if (lastSample <= 14)
+      break;
+    lastSample -= 14;
+    firstSample = 0;
+    in += 8;
+  }
+  *prev1 = p1;
+  *prev2 = p2;
+  return ret;
+}
+
+using DSPDecompressFramesFunc = unsigned (*)(int16_t* out, const uint8_t* in, const int16_t coefs[8][2],
+                                             int16_t* prev1, int16_t* prev2, unsigned firstSample,
+                                             unsigned lastSample);
+
+#if !DSP_X86 && !DSP_NEON
+static unsigned DSPDecompressFramesGeneric(int16_t* out, const uint8_t* in, const int16_t coefs[8][2], int16_t* prev1,
+                                           int16_t* prev2, unsigned firstSample, unsigned lastSample) {
+  return DSPDecompressFramesImp<DSPResidualsGeneric>(out, in, coefs, prev1, prev2, firstSample, lastSample);
+}
+#endif
+
+#if DSP_X86
+static unsigned DSPDecompressFramesSSE2(int16_t* out, const uint8_t* in, const int16_t coefs[8][2], int16_t* prev1,
+                                        int16_t* prev2, unsigned firstSample, unsigned lastSample) {
+  return DSPDecompressFramesImp<DSPResidualsSSE2>(out, in, coefs, prev1, prev2, firstSample, lastSample);
+}
+
+DSP_TARGET("ssse3")
+static unsigned DSPDecompressFramesSSSE3(int16_t* out, const uint8_t* in, const int16_t coefs[8][2], int16_t* prev1,
+                                         int16_t* prev2, unsigned firstSample, unsigned lastSample) {
+  return DSPDecompressFramesImp<DSPResidualsSSSE3>(out, in, coefs, prev1, prev2, firstSample, lastSample);
+}
+
+static bool DSPHasSSSE3() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 9)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("ssse3");
+#endif
+}
+#endif
+
+#if DSP_NEON
+static unsigned DSPDecompressFramesNEON(int16_t* out, const uint8_t* in, const int16_t coefs[8][2], int16_t* prev1,
+                                        int16_t* prev2, unsigned firstSample, unsigned lastSample) {
+  return DSPDecompressFramesImp<DSPResidualsNEON>(out, in, coefs, prev1, prev2, firstSample, lastSample);
+}
+#endif
+
+static DSPDecompressFramesFunc DSPSelectDecompressFrames() {
+#if DSP_X86
+  if (DSPHasSSSE3())
+    return DSPDecompressFramesSSSE3;
+  return DSPDecompressFramesSSE2;
+#elif DSP_NEON
+  return DSPDecompressFramesNEON;
+#else
+  return DSPDecompressFramesGeneric;
+#endif
+}
+
+unsigned DSPDecompressFrames(int16_t* out, const uint8_t* in, const int16_t coefs[8][2], int16_t* prev1,
+                             int16_t* prev2, unsigned lastSample) {
+  return DSPDecompressFramesRanged(out, in, coefs, prev1, prev2, 0, lastSample);
+}
+
+unsigned DSPDecompressFramesRanged(int16_t* out, const uint8_t* in, const int16_t coefs[8][2], int16_t* prev1,
+                                   int16_t* prev2, unsigned firstSample, unsigned lastSample) {
+  static const DSPDecompressFramesFunc Decompress = DSPSelectDecompressFrames();
+  return Decompress(out, in, coefs, prev1, prev2, firstSample, lastSample);
+}
+
 #pragma mark Encoder
 
 /* Reference:
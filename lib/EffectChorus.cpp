@@ -1,10 +1,19 @@
 #include "amuse/EffectChorus.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 #include "amuse/Common.hpp"
 #include "amuse/IBackendVoice.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CHORUS_X86 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define CHORUS_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace amuse {
 
 /* clang-format off */
@@ -140,6 +149,103 @@ constexpr std::array<float, 512> rsmpTab12khz{
 };
 /* clang-format on */
 
+namespace {
+
+/* Four channel lanes processed together; every operation is exact IEEE single precision so lanes
+ * match the scalar per-channel formulation bit for bit */
+#if CHORUS_X86
+using Lanes = __m128;
+Lanes Load(const float* p) { return _mm_loadu_ps(p); }
+void Store(float* p, Lanes v) { _mm_storeu_ps(p, v); }
+Lanes Splat(float v) { return _mm_set1_ps(v); }
+Lanes Add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+Lanes Mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+#elif CHORUS_NEON
+using Lanes = float32x4_t;
+Lanes Load(const float* p) { return vld1q_f32(p); }
+void Store(float* p, Lanes v) { vst1q_f32(p, v); }
+Lanes Splat(float v) { return vdupq_n_f32(v); }
+Lanes Add(Lanes a, Lanes b) { return vaddq_f32(a, b); }
+Lanes Mul(Lanes a, Lanes b) { return vmulq_f32(a, b); }
+#else
+struct Lanes {
+  float v[4];
+};
+Lanes Load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+void Store(float* p, Lanes v) { std::copy(v.v, v.v + 4, p); }
+Lanes Splat(float v) { return {{v, v, v, v}}; }
+Lanes Add(Lanes a, Lanes b) { return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+Lanes Mul(Lanes a, Lanes b) { return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}}; }
+#endif
+
+static_assert(NumChannels == 8, "Rows hold at most two groups of four lanes");
+
+/** One sample of the first 4 * Groups channels */
+template <size_t Groups>
+struct Row {
+  Lanes m_lanes[Groups];
+};
+
+template <size_t Groups>
+Row<Groups> LoadRow(const float* p) {
+  Row<Groups> row;
+  for (size_t g = 0; g < Groups; ++g)
+    row.m_lanes[g] = Load(p + g * 4);
+  return row;
+}
+
+template <size_t Groups>
+void StoreRow(float* p, const Row<Groups>& row) {
+  for (size_t g = 0; g < Groups; ++g)
+    Store(p + g * 4, row.m_lanes[g]);
+}
+
+/** 4-tap interpolation of every lane with the same kernel row, summed in the scalar order */
+template <size_t Groups>
+Row<Groups> Interpolate(const float* selTab, const Row<Groups>& old1, const Row<Groups>& old2,
+                        const Row<Groups>& old3, const Row<Groups>& cur) {
+  const Lanes t0 = Splat(selTab[0]);
+  const Lanes t1 = Splat(selTab[1]);
+  const Lanes t2 = Splat(selTab[2]);
+  const Lanes t3 = Splat(selTab[3]);
+  Row<Groups> row;
+  for (size_t g = 0; g < Groups; ++g)
+    row.m_lanes[g] = Add(Add(Add(Mul(t0, old1.m_lanes[g]), Mul(t1, old2.m_lanes[g])), Mul(t2, old3.m_lanes[g])),
+                         Mul(t3, cur.m_lanes[g]));
+  return row;
+}
+
+/** Write the first `chanCount` lanes of a row as one interleaved output frame */
+template <typename T, size_t Groups>
+void StoreFrame(T* dest, size_t chanCount, const Row<Groups>& row) {
+  alignas(16) std::array<float, Groups * 4> vals;
+  StoreRow(vals.data(), row);
+  for (size_t c = 0; c < chanCount && c < Groups * 4; ++c)
+    dest[c] = ClampFull<T>(vals[c]);
+}
+
+#if CHORUS_X86 || CHORUS_NEON
+/** 16-bit output saturates and truncates in-register, matching ClampFull */
+template <size_t Groups>
+void StoreFrame(int16_t* dest, size_t chanCount, const Row<Groups>& row) {
+  alignas(16) std::array<int16_t, Groups * 4> vals;
+  for (size_t g = 0; g < Groups; ++g) {
+#if CHORUS_X86
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(row.m_lanes[g], _mm_set1_ps(-32768.f)), _mm_set1_ps(32767.f));
+    const __m128i wide = _mm_cvttps_epi32(clamped);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&vals[g * 4]), _mm_packs_epi32(wide, wide));
+#else
+    const float32x4_t clamped = vminq_f32(vmaxq_f32(row.m_lanes[g], vdupq_n_f32(-32768.f)), vdupq_n_f32(32767.f));
+    vst1_s16(&vals[g * 4], vmovn_s32(vcvtq_s32_f32(clamped)));
+#endif
+  }
+  for (size_t c = 0; c < chanCount && c < Groups * 4; ++c)
+    dest[c] = vals[c];
+}
+#endif
+
+} // anonymous namespace
+
 EffectChorus::EffectChorus(uint32_t baseDelay, uint32_t variation, uint32_t period)
 : x90_baseDelay(std::clamp(baseDelay, 5u, 15u))
 , x94_variation(std::clamp(variation, 0u, 5u))
@@ -156,19 +262,15 @@ void EffectChorusImp<T>::_setup(double sampleRate) {
   m_sampsPerMs = std::ceil(sampleRate / 1000.0);
   m_blockSamples = m_sampsPerMs * 5;
 
-  delete[] x0_lastChans[0][0];
-
   const size_t chanPitch = m_blockSamples * AMUSE_CHORUS_NUM_BLOCKS;
-  T* buf = new T[chanPitch * NumChannels]();
-
-  for (size_t c = 0; c < NumChannels; ++c) {
-    for (size_t i = 0; i < AMUSE_CHORUS_NUM_BLOCKS; ++i) {
-      x0_lastChans[c][i] = buf + chanPitch * c + m_blockSamples * i;
-    }
-  }
+  x0_lastChans = std::make_unique<float[]>(chanPitch * NumChannels);
 
   x6c_src.x88_trigger = chanPitch;
 
+  m_fadeBuf = std::make_unique<T[]>(m_blockSamples * NumChannels);
+  m_fadeFrom.m_pending = false;
+  m_primed = false;
+
   m_dirty = true;
 }
 
@@ -177,6 +279,14 @@ void EffectChorusImp<T>::_update() {
   size_t chanPitch = m_blockSamples * AMUSE_CHORUS_NUM_BLOCKS;
   size_t fifteenSamps = 15 * m_sampsPerMs;
 
+  /* Restarting the modulation moves the read position; keep the running state to fade out from */
+  if (m_primed) {
+    m_fadeFrom.m_posLo = x58_currentPosLo;
+    m_fadeFrom.m_posHi = x5c_currentPosHi;
+    m_fadeFrom.m_pitchOffset = x60_pitchOffset;
+    m_fadeFrom.m_pending = true;
+  }
+
   x5c_currentPosHi = m_blockSamples * 2 - (x90_baseDelay - 5) * m_sampsPerMs;
   x58_currentPosLo = 0;
   uint32_t temp = (x5c_currentPosHi + (x24_currentLast - 1) * m_blockSamples);
@@ -190,16 +300,13 @@ void EffectChorusImp<T>::_update() {
 }
 
 template <typename T>
-EffectChorusImp<T>::~EffectChorusImp() {
-  delete[] x0_lastChans[0][0];
-}
-
-template <typename T>
+template <size_t Groups>
 void EffectChorusImp<T>::SrcInfo::doSrc1(size_t blockSamples, size_t chanCount) {
-  float old1 = x74_old[0];
-  float old2 = x74_old[1];
-  float old3 = x74_old[2];
-  float cur = x70_smpBase[x7c_posHi];
+  History& history = *x74_old;
+  Row<Groups> old1 = LoadRow<Groups>(history[0].data());
+  Row<Groups> old2 = LoadRow<Groups>(history[1].data());
+  Row<Groups> old3 = LoadRow<Groups>(history[2].data());
+  Row<Groups> cur = LoadRow<Groups>(&x70_smpBase[x7c_posHi * NumChannels]);
 
   T* dest = x6c_dest;
   for (size_t i = 0; i < blockSamples; ++i) {
@@ -212,30 +319,32 @@ void EffectChorusImp<T>::SrcInfo::doSrc1(size_t blockSamples, size_t chanCount)
       ++x7c_posHi;
       if (x7c_posHi == x88_trigger)
         x7c_posHi = x8c_target;
-      *dest = ClampFull<T>(selTab[0] * old1 + selTab[1] * old2 + selTab[2] * old3 + selTab[3] * cur);
+      StoreFrame(dest, chanCount, Interpolate(selTab, old1, old2, old3, cur));
       dest += chanCount;
       old1 = old2;
       old2 = old3;
       old3 = cur;
-      cur = x70_smpBase[x7c_posHi];
+      cur = LoadRow<Groups>(&x70_smpBase[x7c_posHi * NumChannels]);
     } else {
       x78_posLo = ovrTest;
-      *dest = ClampFull<T>(selTab[0] * old1 + selTab[1] * old2 + selTab[2] * old3 + selTab[3] * cur);
+      StoreFrame(dest, chanCount, Interpolate(selTab, old1, old2, old3, cur));
       dest += chanCount;
     }
   }
 
-  x74_old[0] = old1;
-  x74_old[1] = old2;
-  x74_old[2] = old3;
+  StoreRow(history[0].data(), old1);
+  StoreRow(history[1].data(), old2);
+  StoreRow(history[2].data(), old3);
 }
 
 template <typename T>
+template <size_t Groups>
 void EffectChorusImp<T>::SrcInfo::doSrc2(size_t blockSamples, size_t chanCount) {
-  float old1 = x74_old[0];
-  float old2 = x74_old[1];
-  float old3 = x74_old[2];
-  float cur = x70_smpBase[x7c_posHi];
+  History& history = *x74_old;
+  Row<Groups> old1 = LoadRow<Groups>(history[0].data());
+  Row<Groups> old2 = LoadRow<Groups>(history[1].data());
+  Row<Groups> old3 = LoadRow<Groups>(history[2].data());
+  Row<Groups> cur = LoadRow<Groups>(&x70_smpBase[x7c_posHi * NumChannels]);
 
   T* dest = x6c_dest;
   for (size_t i = 0; i < blockSamples; ++i) {
@@ -252,20 +361,20 @@ void EffectChorusImp<T>::SrcInfo::doSrc2(size_t blockSamples, size_t chanCount)
 
       old1 = old3;
       old2 = cur;
-      old3 = x70_smpBase[x7c_posHi];
+      old3 = LoadRow<Groups>(&x70_smpBase[x7c_posHi * NumChannels]);
 
       ++x7c_posHi;
       if (x7c_posHi == x88_trigger)
         x7c_posHi = x8c_target;
 
-      *dest = ClampFull<T>(selTab[0] * old1 + selTab[1] * old2 + selTab[2] * old3 + selTab[3] * cur);
+      StoreFrame(dest, chanCount, Interpolate(selTab, old1, old2, old3, cur));
       dest += chanCount;
 
-      cur = x70_smpBase[x7c_posHi];
+      cur = LoadRow<Groups>(&x70_smpBase[x7c_posHi * NumChannels]);
     } else {
       x78_posLo = ovrTest;
 
-      *dest = ClampFull<T>(selTab[0] * old1 + selTab[1] * old2 + selTab[2] * old3 + selTab[3] * cur);
+      StoreFrame(dest, chanCount, Interpolate(selTab, old1, old2, old3, cur));
       dest += chanCount;
 
       old1 = old2;
@@ -275,13 +384,51 @@ void EffectChorusImp<T>::SrcInfo::doSrc2(size_t blockSamples, size_t chanCount)
       if (x7c_posHi == x88_trigger)
         x7c_posHi = x8c_target;
 
-      cur = x70_smpBase[x7c_posHi];
+      cur = LoadRow<Groups>(&x70_smpBase[x7c_posHi * NumChannels]);
     }
   }
 
-  x74_old[0] = old1;
-  x74_old[1] = old2;
-  x74_old[2] = old3;
+  StoreRow(history[0].data(), old1);
+  StoreRow(history[1].data(), old2);
+  StoreRow(history[2].data(), old3);
+}
+
+template <typename T>
+void EffectChorusImp<T>::_render(T* out, size_t frames, unsigned chanCount, int32_t pitchOffset, uint32_t& posHi,
+                                 uint32_t& posLo, History& history) {
+  x6c_src.x84_pitchHi = (pitchOffset >> 16) + 1;
+  x6c_src.x80_pitchLo = (pitchOffset << 16);
+  x6c_src.x7c_posHi = posHi;
+  x6c_src.x78_posLo = posLo;
+
+  x6c_src.x6c_dest = out;
+  x6c_src.x70_smpBase = x0_lastChans.get();
+  x6c_src.x74_old = &history;
+
+  /* Interpolate only the lane groups holding live channels */
+  const bool wide = chanCount > 4;
+  switch (x6c_src.x84_pitchHi) {
+  case 0:
+    if (wide)
+      x6c_src.template doSrc1<2>(frames, chanCount);
+    else
+      x6c_src.template doSrc1<1>(frames, chanCount);
+    break;
+  case 1:
+    if (wide)
+      x6c_src.template doSrc2<2>(frames, chanCount);
+    else
+      x6c_src.template doSrc2<1>(frames, chanCount);
+    break;
+  default:
+    break;
+  }
+
+  size_t chanPitch = m_blockSamples * AMUSE_CHORUS_NUM_BLOCKS;
+  size_t fifteenSamps = 15 * m_sampsPerMs;
+
+  posHi = x6c_src.x7c_posHi % (chanPitch / fifteenSamps * fifteenSamps);
+  posLo = x6c_src.x78_posLo;
 }
 
 template <typename T>
@@ -293,58 +440,52 @@ void EffectChorusImp<T>::applyEffect(T* audio, size_t frameCount, const ChannelM
   for (size_t f = 0; f < frameCount;) {
     uint8_t next = x24_currentLast + 1;
     uint8_t buf = next % 3;
-    std::array<T*, 8> bufs{
-        x0_lastChans[0][buf], x0_lastChans[1][buf], x0_lastChans[2][buf], x0_lastChans[3][buf],
-        x0_lastChans[4][buf], x0_lastChans[5][buf], x0_lastChans[6][buf], x0_lastChans[7][buf],
-    };
-
-    T* inBuf = audio;
-    for (size_t s = 0; f < frameCount && s < m_blockSamples; ++s, ++f) {
-      for (size_t c = 0; c < chanMap.m_channelCount && c < NumChannels; ++c) {
-        *bufs[c]++ = *inBuf++;
-      }
-    }
 
-    x6c_src.x84_pitchHi = (x60_pitchOffset >> 16) + 1;
-    x6c_src.x80_pitchLo = (x60_pitchOffset << 16);
+    /* Deinterleave the block once into lane rows */
+    size_t bs = std::min(remFrames, size_t(m_blockSamples));
+    const size_t blockValues = bs * chanMap.m_channelCount;
+    const size_t laneCount = std::min(size_t(chanMap.m_channelCount), NumChannels);
+    float* rows = &x0_lastChans[size_t(buf) * m_blockSamples * NumChannels];
+    for (size_t s = 0; s < bs; ++s) {
+      const T* frame = audio + s * chanMap.m_channelCount;
+      for (size_t c = 0; c < laneCount; ++c)
+        rows[s * NumChannels + c] = float(frame[c]);
+    }
+    f += bs;
+
+    /* Outgoing state renders from its own copy of the history into the fade buffer */
+    if (m_fadeFrom.m_pending) {
+      History fadeHistory = x28_oldChans;
+      std::copy(audio, audio + blockValues, m_fadeBuf.get());
+      _render(m_fadeBuf.get(), bs, chanMap.m_channelCount, m_fadeFrom.m_pitchOffset, m_fadeFrom.m_posHi,
+              m_fadeFrom.m_posLo, fadeHistory);
+    }
 
+    const int32_t pitchOffset = x60_pitchOffset;
     --x64_pitchOffsetPeriodCount;
     if (x64_pitchOffsetPeriodCount == 0) {
       x64_pitchOffsetPeriodCount = x68_pitchOffsetPeriod;
       x60_pitchOffset = -x60_pitchOffset;
     }
 
-    T* outBuf = audio;
-    size_t bs = std::min(remFrames, size_t(m_blockSamples));
-    for (size_t c = 0; c < chanMap.m_channelCount && c < NumChannels; ++c) {
-      x6c_src.x7c_posHi = x5c_currentPosHi;
-      x6c_src.x78_posLo = x58_currentPosLo;
-
-      x6c_src.x6c_dest = outBuf++;
-      x6c_src.x70_smpBase = x0_lastChans[c][0];
-      x6c_src.x74_old = x28_oldChans[c].data();
-
-      switch (x6c_src.x84_pitchHi) {
-      case 0:
-        x6c_src.doSrc1(bs, chanMap.m_channelCount);
-        break;
-      case 1:
-        x6c_src.doSrc2(bs, chanMap.m_channelCount);
-        break;
-      default:
-        break;
+    _render(audio, bs, chanMap.m_channelCount, pitchOffset, x5c_currentPosHi, x58_currentPosLo, x28_oldChans);
+
+    if (m_fadeFrom.m_pending) {
+      for (size_t s = 0; s < bs; ++s) {
+        const float t = float(s + 1) / float(bs);
+        for (size_t c = 0; c < chanMap.m_channelCount; ++c) {
+          T& samp = audio[s * chanMap.m_channelCount + c];
+          const float from = m_fadeBuf[s * chanMap.m_channelCount + c];
+          samp = ClampFull<T>(from + (samp - from) * t);
+        }
       }
+      m_fadeFrom.m_pending = false;
     }
 
-    audio += bs * chanMap.m_channelCount;
+    audio += blockValues;
     remFrames -= bs;
-
-    size_t chanPitch = m_blockSamples * AMUSE_CHORUS_NUM_BLOCKS;
-    size_t fifteenSamps = 15 * m_sampsPerMs;
-
-    x5c_currentPosHi = x6c_src.x7c_posHi % (chanPitch / fifteenSamps * fifteenSamps);
-    x58_currentPosLo = x6c_src.x78_posLo;
     x24_currentLast = buf;
+    m_primed = true;
   }
 }
 
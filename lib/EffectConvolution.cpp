@@ -0,0 +1,552 @@
+#include "amuse/EffectConvolution.hpp"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "amuse/AudioGroupSampleDirectory.hpp"
+#include "amuse/FFT.hpp"
+#include "amuse/Resampler.hpp"
+
+#include <athena/FileReader.hpp>
+
+namespace amuse {
+
+/** A run of equal IR partitions sharing one FFT size.
+ *  At every multiple S of m_partSize input samples a job starts: the newest 2P inputs are transformed into the
+ *  segment's ring of input spectra, each partition's spectrum is multiplied with the input spectrum k blocks older
+ *  and the inverse yields wet output for [S + m_offset - P, S + m_offset). The job is spread over the m_steps
+ *  sub-ticks before that output is due, so large segments never land their whole cost on one block. */
+struct ConvolutionSegment {
+  uint32_t m_partSize;            /**< partition length P; transforms are 2P */
+  uint32_t m_partCount;           /**< partitions in the segment */
+  uint32_t m_offset;              /**< IR offset of the first partition */
+  uint32_t m_steps;               /**< BasePartition sub-ticks a job may span */
+  const FFT* m_fft;               /**< transform of size 2P, owned by the kernel */
+  std::vector<float> m_irSpectra; /**< [irChannel][partition] split spectra, scaled by 1 / 2P */
+  std::vector<float> m_inSpectra; /**< [channel][slot] ring of m_partCount input spectra */
+  std::vector<float> m_accRe;     /**< spectrum accumulator of the channel the job is on */
+  std::vector<float> m_accIm;
+  uint32_t m_slot = 0;     /**< ring index of the newest input spectrum */
+  uint32_t m_jobStart = 0; /**< input time S of the running job */
+  uint32_t m_jobChans = 0; /**< channels the running job covers */
+  uint32_t m_unit = 0;     /**< next unit of the running job; see ConvolutionKernel::_runUnit */
+  uint32_t m_units = 0;    /**< units in the running job; equal to m_unit when idle */
+  uint64_t m_work = 0;     /**< weighted work of the units already run */
+};
+
+/** Prepared IR together with the streaming state that runs it.
+ *  Built whole on the preparation thread so the audio thread never allocates. */
+struct ConvolutionKernel {
+  /** Cost of one transform in partition multiply-accumulates, roughly as measured across partition sizes */
+  static constexpr uint32_t TransformWeight = 16;
+
+  std::vector<std::unique_ptr<FFT>> m_ffts;
+  std::vector<ConvolutionSegment> m_segments;
+  unsigned m_irChannels = 0;
+  double m_tailTime = 0.0;
+
+  std::vector<float> m_inHist;  /**< [channel] input rings of m_ringSize samples */
+  std::vector<float> m_outRing; /**< [channel] wet output accumulated ahead of playback, same size */
+  uint32_t m_ringSize = 0;
+  uint32_t m_now = 0; /**< input samples consumed, wrapping */
+
+  std::vector<float> m_time; /**< transform input/output scratch */
+
+  ConvolutionKernel* m_nextRetired = nullptr;
+
+  ConvolutionKernel(const std::vector<float>& ir, size_t frames, unsigned channels, double sampleRate);
+  uint32_t _runUnit(ConvolutionSegment& seg);
+  void _tick(unsigned chanCount);
+  void process(const float* in, float* wet, size_t frames, unsigned chanCount);
+};
+
+ConvolutionKernel::ConvolutionKernel(const std::vector<float>& ir, size_t frames, unsigned channels,
+                                     double sampleRate)
+: m_irChannels(channels), m_tailTime((frames + EffectConvolution::BasePartition) / sampleRate) {
+  /* Segments of four partitions each, growing 4x until MaxPartition covers the rest of the IR.
+   * A segment of size P starting at IR offset o has o - (P - BasePartition) samples of slack after its job
+   * starts, which always leaves at least one sub-tick given the segments before it. */
+  constexpr uint32_t P0 = EffectConvolution::BasePartition;
+  uint32_t partSize = P0;
+  size_t offset = 0;
+  size_t ringSize = P0 * 2;
+  while (offset < frames) {
+    uint32_t count = uint32_t((frames - offset + partSize - 1) / partSize);
+    if (partSize < EffectConvolution::MaxPartition)
+      count = std::min(count, 4u);
+
+    if (m_ffts.empty() || m_ffts.back()->size() != partSize * 2)
+      m_ffts.push_back(std::make_unique<FFT>(partSize * 2));
+
+    ConvolutionSegment& seg = m_segments.emplace_back();
+    seg.m_partSize = partSize;
+    seg.m_partCount = count;
+    seg.m_offset = uint32_t(offset);
+    seg.m_steps = std::min(partSize / P0, uint32_t((offset + P0 - partSize) / P0) + 1);
+    seg.m_fft = m_ffts.back().get();
+
+    const FFT& fft = *seg.m_fft;
+    const size_t stride = fft.spectrumStride();
+    const float scale = 1.f / float(fft.size());
+    m_time.assign(fft.size(), 0.f);
+    seg.m_irSpectra.resize(size_t(channels) * count * stride * 2);
+    for (unsigned c = 0; c < channels; ++c) {
+      for (uint32_t k = 0; k < count; ++k) {
+        const size_t start = offset + size_t(k) * partSize;
+        const size_t len = std::min(size_t(partSize), frames - start);
+        for (size_t i = 0; i < len; ++i)
+          m_time[i] = ir[(start + i) * channels + c] * scale;
+        std::fill(m_time.begin() + len, m_time.end(), 0.f);
+        float* spec = &seg.m_irSpectra[(size_t(c) * count + k) * stride * 2];
+        fft.forward(m_time.data(), spec, spec + stride);
+      }
+    }
+    seg.m_inSpectra.resize(NumChannels * size_t(count) * stride * 2);
+    seg.m_accRe.resize(stride);
+    seg.m_accIm.resize(stride);
+
+    /* A job still reads the 2P inputs before S a block later, and writes up to o + BasePartition past playback */
+    while (ringSize < std::max(offset + P0, size_t(partSize) * 3))
+      ringSize *= 2;
+
+    offset += size_t(count) * partSize;
+    if (partSize < EffectConvolution::MaxPartition)
+      partSize = std::min(partSize * 4, EffectConvolution::MaxPartition);
+  }
+
+  m_ringSize = uint32_t(ringSize);
+  m_inHist.resize(NumChannels * ringSize);
+  m_outRing.resize(NumChannels * ringSize);
+  m_time.resize(m_ffts.back()->size());
+}
+
+/** Run the next unit of a segment's job and return its weight.
+ *  Each channel takes m_partCount + 2 units in order: the forward transform of the newest input block,
+ *  one multiply-accumulate per partition, then the inverse transform and overlap-add into the output ring. */
+uint32_t ConvolutionKernel::_runUnit(ConvolutionSegment& seg) {
+  const uint32_t mask = m_ringSize - 1;
+  const uint32_t partSize = seg.m_partSize;
+  const uint32_t count = seg.m_partCount;
+  const FFT& fft = *seg.m_fft;
+  const size_t stride = fft.spectrumStride();
+  const unsigned c = seg.m_unit / (count + 2);
+  const uint32_t part = seg.m_unit % (count + 2);
+  ++seg.m_unit;
+
+  float* inSpectra = &seg.m_inSpectra[size_t(c) * count * stride * 2];
+  if (part == 0) {
+    const float* hist = &m_inHist[size_t(c) * m_ringSize];
+    const uint32_t histStart = seg.m_jobStart - partSize * 2;
+    for (uint32_t i = 0; i < partSize * 2; ++i)
+      m_time[i] = hist[(histStart + i) & mask];
+    float* newest = &inSpectra[seg.m_slot * stride * 2];
+    fft.forward(m_time.data(), newest, newest + stride);
+    std::fill(seg.m_accRe.begin(), seg.m_accRe.end(), 0.f);
+    std::fill(seg.m_accIm.begin(), seg.m_accIm.end(), 0.f);
+    return TransformWeight;
+  }
+
+  if (part <= count) {
+    const uint32_t k = part - 1;
+    const float* x = &inSpectra[((seg.m_slot + count - k) % count) * stride * 2];
+    const float* h = &seg.m_irSpectra[(size_t(c % m_irChannels) * count + k) * stride * 2];
+    FFT::MultiplyAccumulate(seg.m_accRe.data(), seg.m_accIm.data(), h, h + stride, x, x + stride, stride);
+    return 1;
+  }
+
+  fft.inverse(seg.m_accRe.data(), seg.m_accIm.data(), m_time.data());
+
+  /* Overlap-save: the second half of the circular result is the linear convolution */
+  float* out = &m_outRing[size_t(c) * m_ringSize];
+  const uint32_t outStart = seg.m_jobStart + seg.m_offset - partSize;
+  for (uint32_t i = 0; i < partSize; ++i)
+    out[(outStart + i) & mask] += m_time[partSize + i];
+  return TransformWeight;
+}
+
+void ConvolutionKernel::_tick(unsigned chanCount) {
+  constexpr uint32_t P0 = EffectConvolution::BasePartition;
+  for (ConvolutionSegment& seg : m_segments) {
+    /* m_steps never exceeds P / BasePartition, so the previous job has always finished by now */
+    if (!(m_now & (seg.m_partSize - 1))) {
+      seg.m_slot = seg.m_slot + 1 == seg.m_partCount ? 0 : seg.m_slot + 1;
+      seg.m_jobStart = m_now;
+      seg.m_jobChans = chanCount;
+      seg.m_unit = 0;
+      seg.m_units = chanCount * (seg.m_partCount + 2);
+      seg.m_work = 0;
+    }
+    if (seg.m_unit == seg.m_units)
+      continue;
+
+    /* Even share of the job's weighted work per sub-tick; the last one finishes whatever remains */
+    const uint32_t step = (m_now - seg.m_jobStart) / P0 + 1;
+    const uint64_t total = uint64_t(seg.m_jobChans) * (seg.m_partCount + 2 * TransformWeight);
+    const uint64_t target = step >= seg.m_steps ? total : total * step / seg.m_steps;
+    while (seg.m_unit < seg.m_units && seg.m_work < target)
+      seg.m_work += _runUnit(seg);
+  }
+}
+
+void ConvolutionKernel::process(const float* in, float* wet, size_t frames, unsigned chanCount) {
+  constexpr uint32_t P0 = EffectConvolution::BasePartition;
+  const uint32_t mask = m_ringSize - 1;
+  for (size_t f = 0; f < frames;) {
+    const size_t count = std::min(frames - f, size_t(P0 - (m_now & (P0 - 1))));
+    for (unsigned c = 0; c < chanCount; ++c) {
+      float* hist = &m_inHist[size_t(c) * m_ringSize];
+      float* out = &m_outRing[size_t(c) * m_ringSize];
+      for (size_t i = 0; i < count; ++i) {
+        const uint32_t t = m_now + uint32_t(i);
+        const size_t idx = (f + i) * chanCount + c;
+        hist[t & mask] = in[idx];
+        float& y = out[(t - P0) & mask];
+        wet[idx] = y;
+        y = 0.f;
+      }
+    }
+    m_now += uint32_t(count);
+    f += count;
+    if (!(m_now & (P0 - 1)))
+      _tick(chanCount);
+  }
+}
+
+namespace {
+
+/** Decode the first channel-interleaved PCM or float data chunk of a WAV file */
+bool ReadWAV(std::string_view path, std::vector<float>& samples, unsigned& channels, double& sampleRate) {
+  athena::io::FileReader r(path);
+  if (r.hasError())
+    return false;
+  if (r.readUint32Little() != SBIG('RIFF'))
+    return false;
+  const atUint64 riffEnd = std::min(atUint64(r.readUint32Little()) + 8, r.length());
+  if (r.readUint32Little() != SBIG('WAVE'))
+    return false;
+
+  WAVFormatChunk fmt;
+  atUint16 format = 0;
+  while (r.position() + 8 <= riffEnd) {
+    const atUint32 chunkMagic = r.readUint32Little();
+    const atUint32 chunkSize = r.readUint32Little();
+    const atUint64 startPos = r.position();
+    if (chunkMagic == SBIG('fmt ')) {
+      fmt.read(r);
+      format = fmt.sampleFmt;
+      /* WAVE_FORMAT_EXTENSIBLE keeps the real format code at the head of its sub-format GUID */
+      if (format == 0xfffe && chunkSize >= 40) {
+        r.seek(startPos + 24, athena::SeekOrigin::Begin);
+        format = r.readUint16Little();
+      }
+    } else if (chunkMagic == SBIG('data') && format) {
+      const unsigned bits = fmt.bitsPerSample;
+      const bool isFloat = format == 3 && bits == 32;
+      const bool isPCM = format == 1 && (bits == 16 || bits == 24 || bits == 32);
+      channels = fmt.numChannels;
+      sampleRate = fmt.sampleRate;
+      if ((!isFloat && !isPCM) || !channels || sampleRate <= 0.0)
+        return false;
+
+      /* Header sizes are untrusted (streamed WAVs leave them at 0xFFFFFFFF); read no more than the file
+       * holds or the IR can use */
+      const unsigned bytes = bits / 8;
+      const atUint64 fileLeft = riffEnd > startPos ? riffEnd - startPos : 0;
+      const auto usable = atUint64(std::ceil(EffectConvolution::MaxIRTime * sampleRate)) * channels * bytes;
+      const size_t count = size_t(std::min({atUint64(chunkSize), fileLeft, usable}) / bytes / channels * channels);
+      std::unique_ptr<uint8_t[]> data(new uint8_t[count * bytes]);
+      r.readUBytesToBuf(data.get(), count * bytes);
+      samples.resize(count);
+      for (size_t i = 0; i < count; ++i) {
+        const uint8_t* p = data.get() + i * bytes;
+        if (bits == 16) {
+          samples[i] = int16_t(p[0] | (p[1] << 8)) / 32768.f;
+        } else if (bits == 24) {
+          samples[i] = int32_t(uint32_t(p[0]) << 8 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 24) / 2147483648.f;
+        } else {
+          const uint32_t v = uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+          if (isFloat)
+            std::memcpy(&samples[i], &v, 4);
+          else
+            samples[i] = int32_t(v) / 2147483648.f;
+        }
+      }
+      return count != 0;
+    }
+    r.seek(startPos + chunkSize + (chunkSize & 1), athena::SeekOrigin::Begin);
+  }
+  return false;
+}
+
+/** Bring an interleaved IR to the output rate, drop its inaudible tail and normalize it to unit energy */
+size_t ConditionIR(const std::vector<float>& src, unsigned channels, double srcRate, double dstRate,
+                   std::vector<float>& dst) {
+  size_t frames = std::min(src.size() / channels, size_t(srcRate * EffectConvolution::MaxIRTime));
+  if (srcRate == dstRate) {
+    dst.assign(src.begin(), src.begin() + frames * channels);
+  } else {
+    const double step = srcRate / dstRate;
+    const size_t outFrames = size_t(std::ceil(frames / step));
+    std::vector<float> chanIn(frames);
+    std::vector<float> chanOut(outFrames);
+    dst.resize(outFrames * channels);
+    for (unsigned c = 0; c < channels; ++c) {
+      for (size_t i = 0; i < frames; ++i)
+        chanIn[i] = src[i * channels + c];
+      Resampler resampler(ResamplerQuality::Sinc);
+      resampler.pushInput(chanIn.data(), frames);
+      chanIn.assign(resampler.inputNeeded(outFrames, step), 0.f);
+      resampler.pushInput(chanIn.data(), chanIn.size());
+      resampler.process(chanOut.data(), outFrames, step);
+      for (size_t i = 0; i < outFrames; ++i)
+        dst[i * channels + c] = chanOut[i];
+      chanIn.resize(frames);
+    }
+    frames = outFrames;
+  }
+
+  float peak = 0.f;
+  double energy = 0.0;
+  for (float s : dst) {
+    peak = std::max(peak, std::abs(s));
+    energy += double(s) * s;
+  }
+  if (peak == 0.f)
+    return 0;
+
+  /* Trailing samples below -90dB of the peak only cost partitions */
+  const float floor = peak * 3.16e-5f;
+  size_t end = dst.size();
+  while (end && std::abs(dst[end - 1]) < floor)
+    --end;
+  frames = (end + channels - 1) / channels;
+  dst.resize(frames * channels);
+
+  const auto scale = float(1.0 / std::sqrt(energy / channels));
+  for (float& s : dst)
+    s *= scale;
+  return frames;
+}
+
+} // anonymous namespace
+
+EffectConvolution::EffectConvolution(float mix, double sampleRate)
+: m_mix(std::clamp(mix, 0.f, 1.f))
+, m_wetBuf(std::make_unique<float[]>(ChunkFrames * NumChannels))
+, m_fadeBuf(std::make_unique<float[]>(ChunkFrames * NumChannels))
+, m_sampleRate(sampleRate) {}
+
+EffectConvolution::~EffectConvolution() {
+  if (m_prepThread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lk(m_prepLock);
+      m_quit = true;
+    }
+    m_prepCv.notify_one();
+    m_prepThread.join();
+  }
+  delete m_pending.exchange(nullptr, std::memory_order_acquire);
+  _freeRetired();
+}
+
+void EffectConvolution::_freeRetired() {
+  ConvolutionKernel* kernel = m_retired.exchange(nullptr, std::memory_order_acquire);
+  while (kernel) {
+    ConvolutionKernel* next = kernel->m_nextRetired;
+    delete kernel;
+    kernel = next;
+  }
+}
+
+void EffectConvolution::_wakePrepare() {
+  if (!m_prepThread.joinable())
+    m_prepThread = std::thread([this]() { _prepareThread(); });
+  m_prepCv.notify_one();
+}
+
+void EffectConvolution::_prepareThread() {
+  uint32_t doneGen = 0;
+  std::unique_lock<std::mutex> lk(m_prepLock);
+  while (!m_quit) {
+    /* The audio thread bumps m_prepGen without taking the lock, so its wake-up may land between the check
+     * and the wait; the timeout bounds how late a rate change is noticed */
+    m_prepCv.wait_for(lk, std::chrono::milliseconds(100),
+                      [&]() { return m_quit || m_prepGen.load(std::memory_order_acquire) != doneGen; });
+    if (m_quit)
+      break;
+
+    const uint32_t gen = m_prepGen.load(std::memory_order_acquire);
+    const bool newSource = std::exchange(m_reqSource, false);
+    std::string path;
+    if (newSource) {
+      path = std::move(m_reqPath);
+      m_reqPath.clear();
+      if (path.empty()) {
+        m_irSamples = std::move(m_reqSamples);
+        m_reqSamples.clear();
+        m_irChannels = m_reqChannels;
+        m_irRate = m_reqRate;
+      }
+    }
+    lk.unlock();
+
+    _freeRetired();
+    ConvolutionIRState state = ConvolutionIRState::None;
+    if (gen != doneGen)
+      state = _prepare(newSource, path);
+    doneGen = gen;
+
+    lk.lock();
+    /* Rate changes re-prepare silently; a newer loadIR/setIR already reported Preparing */
+    if (newSource && !m_reqSource)
+      m_irState.store(state, std::memory_order_release);
+  }
+}
+
+ConvolutionIRState EffectConvolution::_prepare(bool newSource, const std::string& path) {
+  if (newSource && !path.empty()) {
+    std::vector<float> samples;
+    unsigned channels = 0;
+    double rate = 0.0;
+    if (!ReadWAV(path, samples, channels, rate))
+      return ConvolutionIRState::Failed;
+    m_irSamples = std::move(samples);
+    m_irChannels = channels;
+    m_irRate = rate;
+  }
+
+  const double sampleRate = m_sampleRate.load(std::memory_order_acquire);
+  std::vector<float> ir;
+  const size_t frames = m_irChannels ? ConditionIR(m_irSamples, m_irChannels, m_irRate, sampleRate, ir) : 0;
+  if (!frames)
+    return ConvolutionIRState::Failed;
+
+  /* An IR the audio thread has not picked up yet is simply superseded */
+  auto* kernel = new ConvolutionKernel(ir, frames, m_irChannels, sampleRate);
+  delete m_pending.exchange(kernel, std::memory_order_acq_rel);
+  return ConvolutionIRState::Ready;
+}
+
+void EffectConvolution::loadIR(std::string_view path) {
+  m_irPath = path;
+  {
+    std::lock_guard<std::mutex> lk(m_prepLock);
+    m_reqPath = m_irPath;
+    m_reqSamples.clear();
+    m_reqSource = true;
+    m_irState.store(ConvolutionIRState::Preparing, std::memory_order_release);
+    m_prepGen.fetch_add(1, std::memory_order_release);
+  }
+  _wakePrepare();
+}
+
+void EffectConvolution::setIR(const float* samples, size_t frameCount, unsigned channels, double sampleRate) {
+  m_irPath.clear();
+  {
+    std::lock_guard<std::mutex> lk(m_prepLock);
+    m_reqPath.clear();
+    m_reqSamples.assign(samples, samples + frameCount * channels);
+    m_reqChannels = channels;
+    m_reqRate = sampleRate;
+    m_reqSource = true;
+    m_irState.store(ConvolutionIRState::Preparing, std::memory_order_release);
+    m_prepGen.fetch_add(1, std::memory_order_release);
+  }
+  _wakePrepare();
+}
+
+void EffectConvolution::_resetSampleRate(double sampleRate) {
+  /* Called on the audio thread: publish the rate and leave the rebuild to the preparation thread (if one is
+   * running; otherwise the next loadIR/setIR prepares at this rate). The current IR plays until then. */
+  m_sampleRate.store(sampleRate, std::memory_order_release);
+  m_prepGen.fetch_add(1, std::memory_order_release);
+  m_prepCv.notify_one();
+}
+
+void EffectConvolution::_process(float* audio, size_t frameCount, unsigned chanCount) {
+  ConvolutionKernel* fading = nullptr;
+  if (ConvolutionKernel* pending = m_pending.exchange(nullptr, std::memory_order_acquire)) {
+    fading = m_active.release();
+    m_active.reset(pending);
+    m_tailTime = pending->m_tailTime;
+  }
+  if (!m_active)
+    return;
+
+  /* Mix ramps across the call; a replaced IR cross-fades into the new one over the same span */
+  const float mixFrom = m_appliedMix;
+  const float mixStep = (m_mix - mixFrom) / float(frameCount);
+  const float fadeStep = 1.f / float(frameCount);
+  for (size_t f = 0; f < frameCount; f += ChunkFrames) {
+    const size_t count = std::min(frameCount - f, ChunkFrames);
+    float* chunk = audio + f * chanCount;
+    m_active->process(chunk, m_wetBuf.get(), count, chanCount);
+    if (fading)
+      fading->process(chunk, m_fadeBuf.get(), count, chanCount);
+
+    for (size_t i = 0; i < count; ++i) {
+      const float mix = mixFrom + mixStep * float(f + i + 1);
+      const float fade = fadeStep * float(f + i + 1);
+      for (unsigned c = 0; c < chanCount; ++c) {
+        const size_t idx = i * chanCount + c;
+        float wet = m_wetBuf[idx];
+        if (fading)
+          wet = m_fadeBuf[idx] + (wet - m_fadeBuf[idx]) * fade;
+        chunk[idx] += (wet - chunk[idx]) * mix;
+      }
+    }
+  }
+  m_appliedMix = m_mix;
+
+  if (fading) {
+    fading->m_nextRetired = m_retired.load(std::memory_order_relaxed);
+    while (!m_retired.compare_exchange_weak(fading->m_nextRetired, fading, std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+    }
+  }
+}
+
+template <typename T>
+EffectConvolutionImp<T>::EffectConvolutionImp(float mix, double sampleRate)
+: EffectConvolution(mix, sampleRate), m_ioBuf(std::make_unique<float[]>(ChunkFrames * NumChannels)) {}
+
+template <typename T>
+EffectConvolutionImp<T>::EffectConvolutionImp(std::string_view irPath, float mix, double sampleRate)
+: EffectConvolutionImp(mix, sampleRate) {
+  if (!irPath.empty())
+    loadIR(irPath);
+}
+
+template <typename T>
+EffectConvolutionImp<T>::EffectConvolutionImp(const EffectConvolutionInfo& info, double sampleRate)
+: EffectConvolutionImp(info.irPath, info.mix, sampleRate) {}
+
+template <typename T>
+void EffectConvolutionImp<T>::applyEffect(T* audio, size_t frameCount, const ChannelMap& chanMap) {
+  /* Without an IR the effect is transparent; skip the conversions */
+  if (!m_active && !m_pending.load(std::memory_order_relaxed))
+    return;
+
+  const unsigned chanCount = chanMap.m_channelCount;
+  if constexpr (std::is_floating_point_v<T>) {
+    _process(audio, frameCount, chanCount);
+  } else {
+    for (size_t f = 0; f < frameCount; f += ChunkFrames) {
+      const size_t samples = std::min(frameCount - f, ChunkFrames) * chanCount;
+      T* chunk = audio + f * chanCount;
+      for (size_t i = 0; i < samples; ++i)
+        m_ioBuf[i] = float(chunk[i]);
+      _process(m_ioBuf.get(), samples / chanCount, chanCount);
+      for (size_t i = 0; i < samples; ++i)
+        chunk[i] = ClampFull<T>(m_ioBuf[i]);
+    }
+  }
+}
+
+template class EffectConvolutionImp<int16_t>;
+template class EffectConvolutionImp<int32_t>;
+template class EffectConvolutionImp<float>;
+} // namespace amuse
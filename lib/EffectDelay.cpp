@@ -1,6 +1,7 @@
 #include "amuse/EffectDelay.hpp"
 
 #include <cmath>
+#include <limits>
 
 #include "amuse/Common.hpp"
 #include "amuse/IBackendVoice.hpp"
@@ -36,18 +37,25 @@ void EffectDelayImp<T>::_setup(double sampleRate) {
   m_sampsPerMs = std::ceil(sampleRate / 1000.0);
   m_blockSamples = m_sampsPerMs * 5;
 
+  /* Sized for the longest delay so parameter changes never reallocate */
+  m_lineSize = ((5000 - 5) * m_sampsPerMs + 159) / 160 * m_blockSamples;
+  for (size_t i = 0; i < NumChannels; ++i)
+    x30_chanLines[i] = std::make_unique<T[]>(m_lineSize);
+  m_linePos = 0;
+
   _update();
+
+  m_prevSize = x0_currentSize;
+  m_prevFeedback = x18_currentFeedback;
+  m_prevOutput = x24_currentOutput;
 }
 
 template <typename T>
 void EffectDelayImp<T>::_update() {
   for (size_t i = 0; i < NumChannels; ++i) {
     x0_currentSize[i] = ((x3c_delay[i] - 5) * m_sampsPerMs + 159) / 160;
-    xc_currentPos[i] = 0;
     x18_currentFeedback[i] = x48_feedback[i] * 128 / 100;
     x24_currentOutput[i] = x54_output[i] * 128 / 100;
-
-    x30_chanLines[i] = std::make_unique<T[]>(m_blockSamples * x0_currentSize[i]);
   }
 
   m_dirty = false;
@@ -59,18 +67,61 @@ void EffectDelayImp<T>::applyEffect(T* audio, size_t frameCount, const ChannelMa
     _update();
 
   for (size_t f = 0; f < frameCount;) {
+    const size_t blockSamples = std::min(size_t(m_blockSamples), frameCount - f);
     for (unsigned c = 0; c < chanMap.m_channelCount; ++c) {
       T* chanAud = audio + c;
-      for (unsigned i = 0; i < m_blockSamples && f < frameCount; ++i, ++f) {
+      T* line = x30_chanLines[c].get();
+      const uint32_t delay = x0_currentSize[c] * m_blockSamples;
+      const uint32_t prevDelay = m_prevSize[c] * m_blockSamples;
+      const bool ramp = delay != prevDelay || x18_currentFeedback[c] != m_prevFeedback[c] ||
+                        x24_currentOutput[c] != m_prevOutput[c];
+
+      uint32_t pos = m_linePos;
+      for (size_t i = 0; i < blockSamples; ++i) {
         T& liveSamp = chanAud[chanMap.m_channelCount * i];
-        T& samp = x30_chanLines[c][xc_currentPos[c] * m_blockSamples + i];
-        samp = ClampFull<T>(samp * x18_currentFeedback[c] / 128 + liveSamp);
-        liveSamp = samp * x24_currentOutput[c] / 128;
+        float delayed = line[pos >= delay ? pos - delay : pos + m_lineSize - delay];
+        float feedback = x18_currentFeedback[c];
+        float output = x24_currentOutput[c];
+        if (ramp) {
+          /* Cross-fade from the old tap and ramp the gains across the block */
+          const float t = float(i + 1) / float(blockSamples);
+          const float prevDelayed = line[pos >= prevDelay ? pos - prevDelay : pos + m_lineSize - prevDelay];
+          delayed = prevDelayed + (delayed - prevDelayed) * t;
+          feedback = m_prevFeedback[c] + (feedback - m_prevFeedback[c]) * t;
+          output = m_prevOutput[c] + (output - m_prevOutput[c]) * t;
+        }
+        T& samp = line[pos];
+        samp = ClampFull<T>(delayed * feedback / 128 + liveSamp);
+        liveSamp = samp * output / 128;
+        if (++pos == m_lineSize)
+          pos = 0;
       }
-      xc_currentPos[c] = (xc_currentPos[c] + 1) % x0_currentSize[c];
     }
-    audio += chanMap.m_channelCount * m_blockSamples;
+
+    m_linePos = (m_linePos + blockSamples) % m_lineSize;
+    m_prevSize = x0_currentSize;
+    m_prevFeedback = x18_currentFeedback;
+    m_prevOutput = x24_currentOutput;
+    audio += chanMap.m_channelCount * blockSamples;
+    f += blockSamples;
+  }
+}
+
+template <typename T>
+double EffectDelayImp<T>::getTailTime() const {
+  /* Echoes repeat each delay period, attenuated by the feedback gain each time, until 60dB down */
+  double tail = 0.0;
+  for (size_t i = 0; i < NumChannels; ++i) {
+    if (x54_output[i] == 0)
+      continue;
+    const double gain = x48_feedback[i] / 100.0;
+    if (gain >= 1.0)
+      return std::numeric_limits<double>::infinity();
+    const uint32_t delaySamples = ((x3c_delay[i] - 5) * m_sampsPerMs + 159) / 160 * m_blockSamples;
+    const double echoes = gain > 0.0 ? std::log(0.001) / std::log(gain) : 0.0;
+    tail = std::max(tail, delaySamples / (m_sampsPerMs * 1000.0) * (1.0 + echoes));
   }
+  return tail;
 }
 
 template class EffectDelayImp<int16_t>;
@@ -5,6 +5,14 @@
 
 #include "amuse/IBackendVoice.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define REVERB_X86 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define REVERB_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace amuse {
 
 /* clang-format off */
@@ -36,20 +44,112 @@ constexpr std::array<size_t, 8> LPTapDelays{
 
 /* clang-format on */
 
-void ReverbDelayLine::allocate(int32_t delay) {
-  delay += 2;
-  x8_length = delay;
-  xc_inputs = std::make_unique<float[]>(delay);
-  x10_lastInput = 0.f;
-  setdelay(delay / 2);
-  x0_inPoint = 0;
-  x4_outPoint = 0;
+namespace {
+
+/* Four channel lanes processed together; every operation is exact IEEE single precision so lanes
+ * match the scalar per-channel formulation bit for bit */
+#if REVERB_X86
+using Lanes = __m128;
+Lanes Load(const float* p) { return _mm_loadu_ps(p); }
+void Store(float* p, Lanes v) { _mm_storeu_ps(p, v); }
+Lanes Splat(float v) { return _mm_set1_ps(v); }
+Lanes Add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+Lanes Sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+Lanes Mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+Lanes Neg(Lanes a) { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+#elif REVERB_NEON
+using Lanes = float32x4_t;
+Lanes Load(const float* p) { return vld1q_f32(p); }
+void Store(float* p, Lanes v) { vst1q_f32(p, v); }
+Lanes Splat(float v) { return vdupq_n_f32(v); }
+Lanes Add(Lanes a, Lanes b) { return vaddq_f32(a, b); }
+Lanes Sub(Lanes a, Lanes b) { return vsubq_f32(a, b); }
+Lanes Mul(Lanes a, Lanes b) { return vmulq_f32(a, b); }
+Lanes Neg(Lanes a) { return vnegq_f32(a); }
+#else
+struct Lanes {
+  float v[4];
+};
+Lanes Load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+void Store(float* p, Lanes v) { std::copy(v.v, v.v + 4, p); }
+Lanes Splat(float v) { return {{v, v, v, v}}; }
+Lanes Add(Lanes a, Lanes b) { return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+Lanes Sub(Lanes a, Lanes b) { return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}}; }
+Lanes Mul(Lanes a, Lanes b) { return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}}; }
+Lanes Neg(Lanes a) { return {{-a.v[0], -a.v[1], -a.v[2], -a.v[3]}}; }
+#endif
+
+/** Lanes [lane, lane + 4) of the row `pos` in a delay line */
+float* LineRow(const ReverbDelayLine& line, uint32_t pos, unsigned lane) {
+  return &line.m_buf[(pos & line.m_mask) * NumChannels + lane];
+}
+
+/** Write `in` at `pos`, then return the lanes written m_delay samples earlier */
+Lanes DelayTap(ReverbDelayLine& line, uint32_t pos, unsigned lane, Lanes in) {
+  Store(LineRow(line, pos, lane), in);
+  return Load(LineRow(line, pos - line.m_delay, lane));
+}
+
+/** Coefficient moving linearly from `from` to `to` over a block of `1 / invN` samples.
+ *  Without Ramp it holds `to`, leaving the steady-state kernel unchanged */
+template <bool Ramp>
+struct LaneRamp {
+  Lanes m_val;
+  Lanes m_step;
+
+  LaneRamp(float from, float to, float invN) : m_val(Splat(Ramp ? from : to)), m_step(Splat((to - from) * invN)) {}
+
+  /** Value for the next sample; reaches `to` on the last sample of the block */
+  Lanes next() {
+    if constexpr (Ramp)
+      m_val = Add(m_val, m_step);
+    return m_val;
+  }
+};
+
+/** Pre-delay stage; while ramping, cross-fades from the tap at `fromDelay` to the line's current delay */
+template <bool Ramp>
+Lanes PreDelayTap(ReverbDelayLine& line, uint32_t fromDelay, uint32_t pos, unsigned lane, Lanes in,
+                  LaneRamp<Ramp>& fade) {
+  if constexpr (Ramp) {
+    Store(LineRow(line, pos, lane), in);
+    const Lanes oldTap = Load(LineRow(line, pos - fromDelay, lane));
+    const Lanes newTap = Load(LineRow(line, pos - line.m_delay, lane));
+    return Add(oldTap, Mul(Sub(newTap, oldTap), fade.next()));
+  } else {
+    return DelayTap(line, pos, lane, in);
+  }
 }
 
-void ReverbDelayLine::setdelay(int32_t delay) {
-  x4_outPoint = x0_inPoint - delay;
-  while (x4_outPoint < 0)
-    x4_outPoint += x8_length;
+template <typename T>
+void Deinterleave(const T* audio, unsigned chanCount, size_t sampleCount, float* block) {
+  const unsigned laneCount = (chanCount + 3) & ~3u;
+  for (size_t s = 0; s < sampleCount; ++s) {
+    float* row = block + s * NumChannels;
+    for (unsigned c = 0; c < chanCount; ++c)
+      row[c] = audio[s * chanCount + c];
+    for (unsigned c = chanCount; c < laneCount; ++c)
+      row[c] = 0.f;
+  }
+}
+
+template <typename T>
+void Interleave(const float* block, unsigned chanCount, size_t sampleCount, T* audio) {
+  for (size_t s = 0; s < sampleCount; ++s)
+    for (unsigned c = 0; c < chanCount; ++c)
+      audio[s * chanCount + c] = ClampFull<T>(block[s * NumChannels + c]);
+}
+
+} // anonymous namespace
+
+void ReverbDelayLine::allocate(uint32_t maxDelay) {
+  uint32_t rows = 1;
+  while (rows <= maxDelay)
+    rows <<= 1;
+  m_buf = std::make_unique<float[]>(size_t(rows) * NumChannels);
+  m_mask = rows - 1;
+  m_delay = maxDelay;
+  m_lastOut.fill(0.f);
 }
 
 EffectReverbStd::EffectReverbStd(float coloration, float mix, float time, float damping, float preDelay)
@@ -72,29 +172,32 @@ EffectReverbStdImp<T>::EffectReverbStdImp(float coloration, float mix, float tim
 template <typename T>
 void EffectReverbStdImp<T>::_setup(double sampleRate) {
   m_sampleRate = sampleRate;
+
+  /* Line lengths depend only on the sample rate; parameter updates never reallocate */
+  const double rateRatio = m_sampleRate / NativeSampleRate;
+  for (size_t t = 0; t < x78_C.size(); ++t)
+    x78_C[t].allocate(uint32_t(CTapDelays[t] * rateRatio));
+  for (size_t t = 0; t < x0_AP.size(); ++t)
+    x0_AP[t].allocate(uint32_t(APTapDelays[t] * rateRatio));
+  x124_preDelayLine.allocate(std::max(int32_t(m_sampleRate * 0.1f) - 1, 0));
+  x10c_lpLastout.fill(0.f);
+  m_linePos = 0;
+
   _update();
+
+  m_ramp.m_allPassCoef = xf0_allPassCoef;
+  std::copy(xf4_combCoef.begin(), xf4_combCoef.end(), m_ramp.m_combCoef.begin());
+  m_ramp.m_damping = x11c_damping;
+  m_ramp.m_level = x118_level;
+  m_ramp.m_preDelay = x124_preDelayLine.m_delay;
+  m_ramp.m_pending = false;
 }
 
 template <typename T>
 void EffectReverbStdImp<T>::_update() {
   float timeSamples = x148_x1d0_time * m_sampleRate;
-  double rateRatio = m_sampleRate / NativeSampleRate;
-  for (size_t c = 0; c < NumChannels; ++c) {
-    for (size_t t = 0; t < x78_C[c].size(); ++t) {
-      ReverbDelayLine& combLine = x78_C[c][t];
-      size_t tapDelay = CTapDelays[t] * rateRatio;
-      combLine.allocate(tapDelay);
-      combLine.setdelay(tapDelay);
-      xf4_combCoef[c][t] = std::pow(10.f, tapDelay * -3.f / timeSamples);
-    }
-
-    for (size_t t = 0; t < x0_AP[c].size(); ++t) {
-      ReverbDelayLine& allPassLine = x0_AP[c][t];
-      size_t tapDelay = APTapDelays[t] * rateRatio;
-      allPassLine.allocate(tapDelay);
-      allPassLine.setdelay(tapDelay);
-    }
-  }
+  for (size_t t = 0; t < x78_C.size(); ++t)
+    xf4_combCoef[t] = std::pow(10.f, x78_C[t].m_delay * -3.f / timeSamples);
 
   xf0_allPassCoef = x140_x1c8_coloration;
   x118_level = x144_x1cc_mix;
@@ -105,21 +208,88 @@ void EffectReverbStdImp<T>::_update() {
 
   x11c_damping = 1.f - (x11c_damping * 0.8f + 0.05);
 
-  if (x150_x1d8_preDelay != 0.f) {
-    x120_preDelayTime = m_sampleRate * x150_x1d8_preDelay;
-    for (size_t i = 0; i < NumChannels; ++i) {
-      x124_preDelayLine[i] = std::make_unique<float[]>(x120_preDelayTime);
-      x130_preDelayPtr[i] = x124_preDelayLine[i].get();
-    }
-  } else {
-    x120_preDelayTime = 0;
-    for (auto& delayLine : x124_preDelayLine) {
-      delayLine.reset();
+  /* The pre-delay ring wraps one sample early, delaying by one less than its length */
+  x120_preDelayTime = x150_x1d8_preDelay != 0.f ? int32_t(m_sampleRate * x150_x1d8_preDelay) : 0;
+  x124_preDelayLine.m_delay = std::max(x120_preDelayTime - 1, 0);
+
+  m_ramp.m_pending = true;
+  m_dirty = false;
+}
+
+template <typename T>
+template <bool Ramp>
+void EffectReverbStdImp<T>::_handleReverb(unsigned chanCount, size_t sampleCount) {
+  const float invN = 1.f / float(sampleCount);
+  const float wetFrom = m_ramp.m_level * 0.6f;
+  const float wetTo = x118_level * 0.6f;
+  const LaneRamp<Ramp> dampWetInit(wetFrom, wetTo, invN);
+  const LaneRamp<Ramp> dampDryInit(0.6f - wetFrom, 0.6f - wetTo, invN);
+  const LaneRamp<Ramp> allPassCoefInit(m_ramp.m_allPassCoef, xf0_allPassCoef, invN);
+  const LaneRamp<Ramp> dampingInit(m_ramp.m_damping, x11c_damping, invN);
+  const LaneRamp<Ramp> combCoef0Init(m_ramp.m_combCoef[0], xf4_combCoef[0], invN);
+  const LaneRamp<Ramp> combCoef1Init(m_ramp.m_combCoef[1], xf4_combCoef[1], invN);
+  const LaneRamp<Ramp> preDelayFadeInit(0.f, 1.f, invN);
+  const Lanes lpScale = Splat(0.3f);
+
+  for (unsigned lane = 0; lane < chanCount; lane += 4) {
+    LaneRamp<Ramp> dampWet = dampWetInit;
+    LaneRamp<Ramp> dampDry = dampDryInit;
+    LaneRamp<Ramp> allPassCoefRamp = allPassCoefInit;
+    LaneRamp<Ramp> dampingRamp = dampingInit;
+    LaneRamp<Ramp> combCoef0 = combCoef0Init;
+    LaneRamp<Ramp> combCoef1 = combCoef1Init;
+    LaneRamp<Ramp> preDelayFade = preDelayFadeInit;
+
+    Lanes lpLastOut = Load(&x10c_lpLastout[lane]);
+    Lanes lastC0 = Load(&x78_C[0].m_lastOut[lane]);
+    Lanes lastC1 = Load(&x78_C[1].m_lastOut[lane]);
+    Lanes lastAP0 = Load(&x0_AP[0].m_lastOut[lane]);
+    Lanes lastAP1 = Load(&x0_AP[1].m_lastOut[lane]);
+
+    uint32_t pos = m_linePos;
+    for (size_t s = 0; s < sampleCount; ++s, ++pos) {
+      float* row = &m_block[s * NumChannels + lane];
+      const Lanes sample = Load(row);
+      const Lanes allPassCoef = allPassCoefRamp.next();
+
+      /* Pre-delay stage */
+      const Lanes sample2 = PreDelayTap(x124_preDelayLine, m_ramp.m_preDelay, pos, lane, sample, preDelayFade);
+
+      /* Comb filter stage */
+      lastC0 = DelayTap(x78_C[0], pos, lane, Add(Mul(combCoef0.next(), lastC0), sample2));
+      lastC1 = DelayTap(x78_C[1], pos, lane, Add(Mul(combCoef1.next(), lastC1), sample2));
+
+      /* All-pass filter stage */
+      const Lanes inAP0 = Add(Add(Mul(allPassCoef, lastAP0), lastC0), lastC1);
+      const Lanes lowPass = Neg(Sub(Mul(allPassCoef, inAP0), lastAP0));
+      lastAP0 = DelayTap(x0_AP[0], pos, lane, inAP0);
+
+      lpLastOut = Add(Mul(dampingRamp.next(), lpLastOut), Mul(lowPass, lpScale));
+      const Lanes inAP1 = Add(Mul(allPassCoef, lastAP1), lpLastOut);
+      const Lanes allPass = Neg(Sub(Mul(allPassCoef, inAP1), lastAP1));
+      lastAP1 = DelayTap(x0_AP[1], pos, lane, inAP1);
+
+      /* Mix out */
+      Store(row, Add(Mul(dampWet.next(), allPass), Mul(dampDry.next(), sample)));
     }
-    x130_preDelayPtr.fill(nullptr);
+
+    Store(&x10c_lpLastout[lane], lpLastOut);
+    Store(&x78_C[0].m_lastOut[lane], lastC0);
+    Store(&x78_C[1].m_lastOut[lane], lastC1);
+    Store(&x0_AP[0].m_lastOut[lane], lastAP0);
+    Store(&x0_AP[1].m_lastOut[lane], lastAP1);
   }
 
-  m_dirty = false;
+  m_linePos += uint32_t(sampleCount);
+
+  if constexpr (Ramp) {
+    m_ramp.m_allPassCoef = xf0_allPassCoef;
+    std::copy(xf4_combCoef.begin(), xf4_combCoef.end(), m_ramp.m_combCoef.begin());
+    m_ramp.m_damping = x11c_damping;
+    m_ramp.m_level = x118_level;
+    m_ramp.m_preDelay = x124_preDelayLine.m_delay;
+    m_ramp.m_pending = false;
+  }
 }
 
 template <typename T>
@@ -127,95 +297,14 @@ void EffectReverbStdImp<T>::applyEffect(T* audio, size_t frameCount, const Chann
   if (m_dirty)
     _update();
 
-  const float dampWet = x118_level * 0.6f;
-  const float dampDry = 0.6f - dampWet;
-
   for (size_t f = 0; f < frameCount; f += 160) {
-    for (unsigned c = 0; c < chanMap.m_channelCount; ++c) {
-      const auto& combCoefs = xf4_combCoef[c];
-      float& lpLastOut = x10c_lpLastout[c];
-      float* preDelayLine = x124_preDelayLine[c].get();
-      float* preDelayPtr = x130_preDelayPtr[c];
-      float* lastPreDelaySamp = &preDelayLine[x120_preDelayTime - 1];
-
-      auto& linesC = x78_C[c];
-      auto& linesAP = x0_AP[c];
-
-      const int procSamples = std::min(size_t(160), frameCount - f);
-      for (int s = 0; s < procSamples; ++s) {
-        const float sample = audio[s * chanMap.m_channelCount + c];
-
-        /* Pre-delay stage */
-        float sample2 = sample;
-        if (x120_preDelayTime != 0) {
-          sample2 = *preDelayPtr;
-          *preDelayPtr = sample;
-          preDelayPtr += 1;
-          if (preDelayPtr == lastPreDelaySamp)
-            preDelayPtr = preDelayLine;
-        }
-
-        /* Comb filter stage */
-        linesC[0].xc_inputs[linesC[0].x0_inPoint] = combCoefs[0] * linesC[0].x10_lastInput + sample2;
-        linesC[0].x0_inPoint += 1;
-
-        linesC[1].xc_inputs[linesC[1].x0_inPoint] = combCoefs[1] * linesC[1].x10_lastInput + sample2;
-        linesC[1].x0_inPoint += 1;
-
-        linesC[0].x10_lastInput = linesC[0].xc_inputs[linesC[0].x4_outPoint];
-        linesC[0].x4_outPoint += 1;
-
-        linesC[1].x10_lastInput = linesC[1].xc_inputs[linesC[1].x4_outPoint];
-        linesC[1].x4_outPoint += 1;
-
-        if (linesC[0].x0_inPoint == linesC[0].x8_length)
-          linesC[0].x0_inPoint = 0;
-
-        if (linesC[1].x0_inPoint == linesC[1].x8_length)
-          linesC[1].x0_inPoint = 0;
-
-        if (linesC[0].x4_outPoint == linesC[0].x8_length)
-          linesC[0].x4_outPoint = 0;
-
-        if (linesC[1].x4_outPoint == linesC[1].x8_length)
-          linesC[1].x4_outPoint = 0;
-
-        /* All-pass filter stage */
-        linesAP[0].xc_inputs[linesAP[0].x0_inPoint] =
-            xf0_allPassCoef * linesAP[0].x10_lastInput + linesC[0].x10_lastInput + linesC[1].x10_lastInput;
-        const float lowPass =
-            -(xf0_allPassCoef * linesAP[0].xc_inputs[linesAP[0].x0_inPoint] - linesAP[0].x10_lastInput);
-        linesAP[0].x0_inPoint += 1;
-
-        linesAP[0].x10_lastInput = linesAP[0].xc_inputs[linesAP[0].x4_outPoint];
-        linesAP[0].x4_outPoint += 1;
-
-        if (linesAP[0].x0_inPoint == linesAP[0].x8_length)
-          linesAP[0].x0_inPoint = 0;
-
-        if (linesAP[0].x4_outPoint == linesAP[0].x8_length)
-          linesAP[0].x4_outPoint = 0;
-
-        lpLastOut = x11c_damping * lpLastOut + lowPass * 0.3f;
-        linesAP[1].xc_inputs[linesAP[1].x0_inPoint] = xf0_allPassCoef * linesAP[1].x10_lastInput + lpLastOut;
-        const float allPass =
-            -(xf0_allPassCoef * linesAP[1].xc_inputs[linesAP[1].x0_inPoint] - linesAP[1].x10_lastInput);
-        linesAP[1].x0_inPoint += 1;
-
-        linesAP[1].x10_lastInput = linesAP[1].xc_inputs[linesAP[1].x4_outPoint];
-        linesAP[1].x4_outPoint += 1;
-
-        if (linesAP[1].x0_inPoint == linesAP[1].x8_length)
-          linesAP[1].x0_inPoint = 0;
-
-        if (linesAP[1].x4_outPoint == linesAP[1].x8_length)
-          linesAP[1].x4_outPoint = 0;
-
-        /* Mix out */
-        audio[s * chanMap.m_channelCount + c] = ClampFull<T>(dampWet * allPass + dampDry * sample);
-      }
-      x130_preDelayPtr[c] = preDelayPtr;
-    }
+    const size_t blockSamples = std::min(size_t(160), frameCount - f);
+    Deinterleave(audio, chanMap.m_channelCount, blockSamples, m_block.data());
+    if (m_ramp.m_pending)
+      _handleReverb<true>(chanMap.m_channelCount, blockSamples);
+    else
+      _handleReverb<false>(chanMap.m_channelCount, blockSamples);
+    Interleave(m_block.data(), chanMap.m_channelCount, blockSamples, audio);
     audio += chanMap.m_channelCount * 160;
   }
 }
@@ -230,35 +319,39 @@ EffectReverbHiImp<T>::EffectReverbHiImp(float coloration, float mix, float time,
 template <typename T>
 void EffectReverbHiImp<T>::_setup(double sampleRate) {
   m_sampleRate = sampleRate;
+
+  /* Line lengths depend only on the sample rate; parameter updates never reallocate */
+  const double rateRatio = m_sampleRate / NativeSampleRate;
+  for (size_t t = 0; t < xb4_C.size(); ++t)
+    xb4_C[t].allocate(uint32_t(CTapDelays[t] * rateRatio));
+  for (size_t t = 0; t < x0_AP.size(); ++t)
+    x0_AP[t].allocate(uint32_t(APTapDelays[t] * rateRatio));
+
+  /* Low-pass lines differ per channel; one ring sized for the longest serves all lanes */
+  for (size_t c = 0; c < NumChannels; ++c)
+    m_lpDelays[c] = uint32_t(LPTapDelays[c] * rateRatio);
+  x78_LP.allocate(*std::max_element(m_lpDelays.begin(), m_lpDelays.end()));
+
+  x1ac_preDelayLine.allocate(std::max(int32_t(m_sampleRate * 0.1f) - 1, 0));
+  x190_lpLastout.fill(0.f);
+  m_linePos = 0;
+
   _update();
+
+  m_ramp.m_allPassCoef = x168_allPassCoef;
+  m_ramp.m_combCoef = x16c_combCoef;
+  m_ramp.m_damping = x1a0_damping;
+  m_ramp.m_level = x19c_level;
+  m_ramp.m_crosstalk = x1a8_internalCrosstalk;
+  m_ramp.m_preDelay = x1ac_preDelayLine.m_delay;
+  m_ramp.m_pending = false;
 }
 
 template <typename T>
 void EffectReverbHiImp<T>::_update() {
   const float timeSamples = x148_x1d0_time * m_sampleRate;
-  const double rateRatio = m_sampleRate / NativeSampleRate;
-
-  for (size_t c = 0; c < NumChannels; ++c) {
-    for (size_t t = 0; t < xb4_C[c].size(); ++t) {
-      ReverbDelayLine& combLine = xb4_C[c][t];
-      const size_t tapDelay = CTapDelays[t] * rateRatio;
-      combLine.allocate(tapDelay);
-      combLine.setdelay(tapDelay);
-      x16c_combCoef[c][t] = std::pow(10.f, tapDelay * -3.f / timeSamples);
-    }
-
-    for (size_t t = 0; t < x0_AP[c].size(); ++t) {
-      ReverbDelayLine& allPassLine = x0_AP[c][t];
-      const size_t tapDelay = APTapDelays[t] * rateRatio;
-      allPassLine.allocate(tapDelay);
-      allPassLine.setdelay(tapDelay);
-    }
-
-    ReverbDelayLine& lpLine = x78_LP[c];
-    const size_t tapDelay = LPTapDelays[c] * rateRatio;
-    lpLine.allocate(tapDelay);
-    lpLine.setdelay(tapDelay);
-  }
+  for (size_t t = 0; t < xb4_C.size(); ++t)
+    x16c_combCoef[t] = std::pow(10.f, xb4_C[t].m_delay * -3.f / timeSamples);
 
   x168_allPassCoef = x140_x1c8_coloration;
   x19c_level = x144_x1cc_mix;
@@ -269,148 +362,114 @@ void EffectReverbHiImp<T>::_update() {
 
   x1a0_damping = 1.f - (x1a0_damping * 0.8f + 0.05);
 
-  if (x150_x1d8_preDelay != 0.f) {
-    x1a4_preDelayTime = m_sampleRate * x150_x1d8_preDelay;
-    for (size_t i = 0; i < NumChannels; ++i) {
-      x1ac_preDelayLine[i] = std::make_unique<float[]>(x1a4_preDelayTime);
-      x1b8_preDelayPtr[i] = x1ac_preDelayLine[i].get();
-    }
-  } else {
-    x1a4_preDelayTime = 0;
-    for (auto& delayLine : x1ac_preDelayLine) {
-      delayLine.reset();
-    }
-    x1b8_preDelayPtr.fill(nullptr);
-  }
+  /* The pre-delay ring wraps one sample early, delaying by one less than its length */
+  x1a4_preDelayTime = x150_x1d8_preDelay != 0.f ? int32_t(m_sampleRate * x150_x1d8_preDelay) : 0;
+  x1ac_preDelayLine.m_delay = std::max(x1a4_preDelayTime - 1, 0);
 
   x1a8_internalCrosstalk = x1dc_crosstalk;
+  m_ramp.m_pending = true;
   m_dirty = false;
 }
 
 template <typename T>
-void EffectReverbHiImp<T>::_handleReverb(T* audio, int c, int chanCount, int sampleCount) {
-  const float dampWet = x19c_level * 0.6f;
-  const float dampDry = 0.6f - dampWet;
-
-  const auto& combCoefs = x16c_combCoef[c];
-  float& lpLastOut = x190_lpLastout[c];
-  float* preDelayLine = x1ac_preDelayLine[c].get();
-  float* preDelayPtr = x1b8_preDelayPtr[c];
-  float* lastPreDelaySamp = &preDelayLine[x1a4_preDelayTime - 1];
-
-  auto& linesC = xb4_C[c];
-  auto& linesAP = x0_AP[c];
-  ReverbDelayLine& lineLP = x78_LP[c];
-
-  const float allPassCoef = x168_allPassCoef;
-  const float damping = x1a0_damping;
-  const int32_t preDelayTime = x1a4_preDelayTime;
-
-  for (int s = 0; s < sampleCount; ++s) {
-    const float sample = audio[s * chanCount + c];
-
-    /* Pre-delay stage */
-    float sample2 = sample;
-    if (preDelayTime != 0) {
-      sample2 = *preDelayPtr;
-      *preDelayPtr = sample;
-      preDelayPtr += 1;
-      if (preDelayPtr == lastPreDelaySamp)
-        preDelayPtr = preDelayLine;
+template <bool Ramp>
+void EffectReverbHiImp<T>::_handleReverb(unsigned chanCount, size_t sampleCount) {
+  const float invN = 1.f / float(sampleCount);
+  const float wetFrom = m_ramp.m_level * 0.6f;
+  const float wetTo = x19c_level * 0.6f;
+  const LaneRamp<Ramp> dampWetInit(wetFrom, wetTo, invN);
+  const LaneRamp<Ramp> dampDryInit(0.6f - wetFrom, 0.6f - wetTo, invN);
+  const LaneRamp<Ramp> allPassCoefInit(m_ramp.m_allPassCoef, x168_allPassCoef, invN);
+  const LaneRamp<Ramp> dampingInit(m_ramp.m_damping, x1a0_damping, invN);
+  const LaneRamp<Ramp> combCoef0Init(m_ramp.m_combCoef[0], x16c_combCoef[0], invN);
+  const LaneRamp<Ramp> combCoef1Init(m_ramp.m_combCoef[1], x16c_combCoef[1], invN);
+  const LaneRamp<Ramp> combCoef2Init(m_ramp.m_combCoef[2], x16c_combCoef[2], invN);
+  const LaneRamp<Ramp> preDelayFadeInit(0.f, 1.f, invN);
+  const Lanes lpScale = Splat(0.3f);
+
+  for (unsigned lane = 0; lane < chanCount; lane += 4) {
+    LaneRamp<Ramp> dampWet = dampWetInit;
+    LaneRamp<Ramp> dampDry = dampDryInit;
+    LaneRamp<Ramp> allPassCoefRamp = allPassCoefInit;
+    LaneRamp<Ramp> dampingRamp = dampingInit;
+    LaneRamp<Ramp> combCoef0 = combCoef0Init;
+    LaneRamp<Ramp> combCoef1 = combCoef1Init;
+    LaneRamp<Ramp> combCoef2 = combCoef2Init;
+    LaneRamp<Ramp> preDelayFade = preDelayFadeInit;
+
+    Lanes lpLastOut = Load(&x190_lpLastout[lane]);
+    Lanes lastC0 = Load(&xb4_C[0].m_lastOut[lane]);
+    Lanes lastC1 = Load(&xb4_C[1].m_lastOut[lane]);
+    Lanes lastC2 = Load(&xb4_C[2].m_lastOut[lane]);
+    Lanes lastAP0 = Load(&x0_AP[0].m_lastOut[lane]);
+    Lanes lastAP1 = Load(&x0_AP[1].m_lastOut[lane]);
+    Lanes lastLP = Load(&x78_LP.m_lastOut[lane]);
+    const uint32_t* lpDelays = &m_lpDelays[lane];
+
+    uint32_t pos = m_linePos;
+    for (size_t s = 0; s < sampleCount; ++s, ++pos) {
+      float* row = &m_block[s * NumChannels + lane];
+      const Lanes sample = Load(row);
+      const Lanes allPassCoef = allPassCoefRamp.next();
+
+      /* Pre-delay stage */
+      const Lanes sample2 = PreDelayTap(x1ac_preDelayLine, m_ramp.m_preDelay, pos, lane, sample, preDelayFade);
+
+      /* Comb filter stage */
+      lastC0 = DelayTap(xb4_C[0], pos, lane, Add(Mul(combCoef0.next(), lastC0), sample2));
+      lastC1 = DelayTap(xb4_C[1], pos, lane, Add(Mul(combCoef1.next(), lastC1), sample2));
+      lastC2 = DelayTap(xb4_C[2], pos, lane, Add(Mul(combCoef2.next(), lastC2), sample2));
+
+      /* All-pass filter stage */
+      const Lanes inAP0 = Add(Add(Add(Mul(allPassCoef, lastAP0), lastC0), lastC1), lastC2);
+      const Lanes inAP1 = Sub(Mul(allPassCoef, lastAP1), Sub(Mul(allPassCoef, inAP0), lastAP0));
+      const Lanes lowPass = Neg(Sub(Mul(allPassCoef, inAP1), lastAP1));
+      lastAP0 = DelayTap(x0_AP[0], pos, lane, inAP0);
+      lastAP1 = DelayTap(x0_AP[1], pos, lane, inAP1);
+
+      /* Per-channel low-pass stage; lanes read back at their own delays */
+      lpLastOut = Add(Mul(dampingRamp.next(), lpLastOut), Mul(lowPass, lpScale));
+      const Lanes inLP = Add(Mul(allPassCoef, lastLP), lpLastOut);
+      const Lanes allPass = Neg(Sub(Mul(allPassCoef, inLP), lastLP));
+      Store(LineRow(x78_LP, pos, lane), inLP);
+      alignas(16) float outLP[4];
+      for (unsigned l = 0; l < 4; ++l)
+        outLP[l] = LineRow(x78_LP, pos - lpDelays[l], lane)[l];
+      lastLP = Load(outLP);
+
+      /* Mix out */
+      Store(row, Add(Mul(dampWet.next(), allPass), Mul(dampDry.next(), sample)));
     }
 
-    /* Comb filter stage */
-    linesC[0].xc_inputs[linesC[0].x0_inPoint] = combCoefs[0] * linesC[0].x10_lastInput + sample2;
-    linesC[0].x0_inPoint += 1;
-
-    linesC[1].xc_inputs[linesC[1].x0_inPoint] = combCoefs[1] * linesC[1].x10_lastInput + sample2;
-    linesC[1].x0_inPoint += 1;
-
-    linesC[2].xc_inputs[linesC[2].x0_inPoint] = combCoefs[2] * linesC[2].x10_lastInput + sample2;
-    linesC[2].x0_inPoint += 1;
-
-    linesC[0].x10_lastInput = linesC[0].xc_inputs[linesC[0].x4_outPoint];
-    linesC[0].x4_outPoint += 1;
-
-    linesC[1].x10_lastInput = linesC[1].xc_inputs[linesC[1].x4_outPoint];
-    linesC[1].x4_outPoint += 1;
-
-    linesC[2].x10_lastInput = linesC[2].xc_inputs[linesC[2].x4_outPoint];
-    linesC[2].x4_outPoint += 1;
-
-    if (linesC[0].x0_inPoint == linesC[0].x8_length)
-      linesC[0].x0_inPoint = 0;
-
-    if (linesC[1].x0_inPoint == linesC[1].x8_length)
-      linesC[1].x0_inPoint = 0;
-
-    if (linesC[2].x0_inPoint == linesC[2].x8_length)
-      linesC[2].x0_inPoint = 0;
-
-    if (linesC[0].x4_outPoint == linesC[0].x8_length)
-      linesC[0].x4_outPoint = 0;
-
-    if (linesC[1].x4_outPoint == linesC[1].x8_length)
-      linesC[1].x4_outPoint = 0;
-
-    if (linesC[2].x4_outPoint == linesC[2].x8_length)
-      linesC[2].x4_outPoint = 0;
-
-    /* All-pass filter stage */
-    linesAP[0].xc_inputs[linesAP[0].x0_inPoint] = allPassCoef * linesAP[0].x10_lastInput + linesC[0].x10_lastInput +
-                                                  linesC[1].x10_lastInput + linesC[2].x10_lastInput;
-
-    linesAP[1].xc_inputs[linesAP[1].x0_inPoint] =
-        allPassCoef * linesAP[1].x10_lastInput -
-        (allPassCoef * linesAP[0].xc_inputs[linesAP[0].x0_inPoint] - linesAP[0].x10_lastInput);
-
-    const float lowPass = -(allPassCoef * linesAP[1].xc_inputs[linesAP[1].x0_inPoint] - linesAP[1].x10_lastInput);
-    linesAP[0].x0_inPoint += 1;
-    linesAP[1].x0_inPoint += 1;
-
-    if (linesAP[0].x0_inPoint == linesAP[0].x8_length)
-      linesAP[0].x0_inPoint = 0;
-
-    if (linesAP[1].x0_inPoint == linesAP[1].x8_length)
-      linesAP[1].x0_inPoint = 0;
-
-    linesAP[0].x10_lastInput = linesAP[0].xc_inputs[linesAP[0].x4_outPoint];
-    linesAP[0].x4_outPoint += 1;
-
-    linesAP[1].x10_lastInput = linesAP[1].xc_inputs[linesAP[1].x4_outPoint];
-    linesAP[1].x4_outPoint += 1;
-
-    if (linesAP[0].x4_outPoint == linesAP[0].x8_length)
-      linesAP[0].x4_outPoint = 0;
-
-    if (linesAP[1].x4_outPoint == linesAP[1].x8_length)
-      linesAP[1].x4_outPoint = 0;
-
-    lpLastOut = damping * lpLastOut + lowPass * 0.3f;
-    lineLP.xc_inputs[lineLP.x0_inPoint] = allPassCoef * lineLP.x10_lastInput + lpLastOut;
-    const float allPass = -(allPassCoef * lineLP.xc_inputs[lineLP.x0_inPoint] - lineLP.x10_lastInput);
-    lineLP.x0_inPoint += 1;
-
-    lineLP.x10_lastInput = lineLP.xc_inputs[lineLP.x4_outPoint];
-    lineLP.x4_outPoint += 1;
-
-    if (lineLP.x0_inPoint == lineLP.x8_length)
-      lineLP.x0_inPoint = 0;
+    Store(&x190_lpLastout[lane], lpLastOut);
+    Store(&xb4_C[0].m_lastOut[lane], lastC0);
+    Store(&xb4_C[1].m_lastOut[lane], lastC1);
+    Store(&xb4_C[2].m_lastOut[lane], lastC2);
+    Store(&x0_AP[0].m_lastOut[lane], lastAP0);
+    Store(&x0_AP[1].m_lastOut[lane], lastAP1);
+    Store(&x78_LP.m_lastOut[lane], lastLP);
+  }
 
-    if (lineLP.x4_outPoint == lineLP.x8_length)
-      lineLP.x4_outPoint = 0;
+  m_linePos += uint32_t(sampleCount);
 
-    /* Mix out */
-    audio[s * chanCount + c] = ClampFull<T>(dampWet * allPass + dampDry * sample);
+  if constexpr (Ramp) {
+    m_ramp.m_allPassCoef = x168_allPassCoef;
+    m_ramp.m_combCoef = x16c_combCoef;
+    m_ramp.m_damping = x1a0_damping;
+    m_ramp.m_level = x19c_level;
+    m_ramp.m_crosstalk = x1a8_internalCrosstalk;
+    m_ramp.m_preDelay = x1ac_preDelayLine.m_delay;
+    m_ramp.m_pending = false;
   }
-
-  x1b8_preDelayPtr[c] = preDelayPtr;
 }
 
 template <typename T>
-void EffectReverbHiImp<T>::_doCrosstalk(T* audio, float wet, float dry, int chanCount, int sampleCount) {
+void EffectReverbHiImp<T>::_doCrosstalk(T* audio, float wetFrom, float wetTo, int chanCount, int sampleCount) {
+  const float wetStep = (wetTo - wetFrom) / float(sampleCount);
   for (int i = 0; i < sampleCount; ++i) {
     T* base = &audio[chanCount * i];
+    const float wet = wetFrom == wetTo ? wetTo : wetFrom + wetStep * float(i + 1);
+    const float dry = 1.f - wet;
     float allWet = 0;
     for (int c = 0; c < chanCount; ++c) {
       allWet += base[c] * wet;
@@ -427,14 +486,16 @@ void EffectReverbHiImp<T>::applyEffect(T* audio, size_t frameCount, const Channe
     _update();
 
   for (size_t f = 0; f < frameCount; f += 160) {
-    size_t blockSamples = std::min(size_t(160), frameCount - f);
-    for (unsigned i = 0; i < chanMap.m_channelCount; ++i) {
-      if (i == 0 && x1a8_internalCrosstalk != 0.f) {
-        float crossWet = x1a8_internalCrosstalk * 0.5;
-        _doCrosstalk(audio, crossWet, 1.f - crossWet, chanMap.m_channelCount, blockSamples);
-      }
-      _handleReverb(audio, i, chanMap.m_channelCount, blockSamples);
-    }
+    const size_t blockSamples = std::min(size_t(160), frameCount - f);
+    const float crossFrom = m_ramp.m_pending ? m_ramp.m_crosstalk : x1a8_internalCrosstalk;
+    if (crossFrom != 0.f || x1a8_internalCrosstalk != 0.f)
+      _doCrosstalk(audio, crossFrom * 0.5f, x1a8_internalCrosstalk * 0.5f, chanMap.m_channelCount, blockSamples);
+    Deinterleave(audio, chanMap.m_channelCount, blockSamples, m_block.data());
+    if (m_ramp.m_pending)
+      _handleReverb<true>(chanMap.m_channelCount, blockSamples);
+    else
+      _handleReverb<false>(chanMap.m_channelCount, blockSamples);
+    Interleave(m_block.data(), chanMap.m_channelCount, blockSamples, audio);
     audio += chanMap.m_channelCount * 160;
   }
 }
@@ -26,8 +26,14 @@ Engine::~Engine() {
     vox->_destroy();
 }
 
-Engine::Engine(IBackendVoiceAllocator& backend, AmplitudeMode ampMode)
-: m_backend(backend), m_ampMode(ampMode), m_defaultStudio(_allocateStudio(true)) {
+/* Stolen voices keep their slot for the 10ms fade-out, so the pool holds a quarter more slots than
+ * the polyphony limit to let the voice that stole one start */
+Engine::Engine(IBackendVoiceAllocator& backend, AmplitudeMode ampMode, size_t voiceCapacity)
+: m_backend(backend)
+, m_ampMode(ampMode)
+, m_voicePool(MakeObj<VoicePool>(voiceCapacity + (voiceCapacity + 3) / 4))
+, m_maxVoices(voiceCapacity)
+, m_defaultStudio(_allocateStudio(true)) {
   m_defaultStudio->getAuxA().makeReverbStd(0.5f, 0.8f, 3.0f, 0.5f, 0.1f);
   m_defaultStudio->getAuxB().makeChorus(15, 0, 500);
   m_defaultStudioReady = true;
@@ -35,6 +41,13 @@ Engine::Engine(IBackendVoiceAllocator& backend, AmplitudeMode ampMode)
   m_midiReader = backend.allocateMIDIReader(*this);
 }
 
+void Engine::setRenderThreads(size_t threads, const std::vector<int>& cpuAffinity) {
+  if (threads <= 1)
+    m_renderPool.reset();
+  else
+    m_renderPool = std::make_unique<RenderPool>(threads, cpuAffinity);
+}
+
 std::pair<AudioGroup*, const SongGroupIndex*> Engine::_findSongGroup(GroupId groupId) const {
   for (const auto& pair : m_audioGroups) {
     const SongGroupIndex* ret = pair.second->getProj().getSongGroupIndex(groupId);
@@ -53,14 +66,83 @@ std::pair<AudioGroup*, const SFXGroupIndex*> Engine::_findSFXGroup(GroupId group
   return {};
 }
 
+/* Dead voices are free for the taking; otherwise lowest priority, then lowest age count, then earliest started */
+static bool IsBetterStealCandidate(const Voice& vox, const Voice* best) {
+  if (!best)
+    return true;
+  const bool voxDead = vox.state() == VoiceState::Dead;
+  const bool bestDead = best->state() == VoiceState::Dead;
+  if (voxDead != bestDead)
+    return voxDead;
+  if (vox.getPriority() != best->getPriority())
+    return vox.getPriority() < best->getPriority();
+  if (vox.getAgeCount() != best->getAgeCount())
+    return vox.getAgeCount() < best->getAgeCount();
+  return vox.vid() < best->vid();
+}
+
+bool Engine::_reserveVoice(uint8_t priority, uint8_t maxVoices, const void* limitTag) {
+  /* Per page/SFX limit: retriggering past maxVoices replaces the oldest instance */
+  if (limitTag && maxVoices) {
+    size_t count = 0;
+    Voice* victim = nullptr;
+    for (ObjToken<Voice>& vox : m_activeVoices) {
+      vox->_visitVoices([&](Voice& v) {
+        if (v.m_limitTag != limitTag || v._isStolen())
+          return;
+        ++count;
+        if (IsBetterStealCandidate(v, victim))
+          victim = &v;
+      });
+    }
+    if (count >= maxVoices && victim)
+      victim->_steal();
+  }
+
+  /* Engine-wide limit: only voices of equal or lower priority may be stolen */
+  if (m_numPolyVoices >= m_maxVoices) {
+    Voice* victim = nullptr;
+    for (ObjToken<Voice>& vox : m_activeVoices) {
+      vox->_visitVoices([&](Voice& v) {
+        if (!v._isStolen() && IsBetterStealCandidate(v, victim))
+          victim = &v;
+      });
+    }
+    if (!victim || (victim->state() != VoiceState::Dead && victim->getPriority() > priority))
+      return false;
+    victim->_steal();
+  }
+
+  return true;
+}
+
+std::unique_ptr<IBackendVoice> Engine::_bindBackendVoice(Voice& vox, double sampleRate, bool dynamicPitch) {
+  /* Rebind the backend voice the slot's previous occupant released before asking for a new one */
+  std::unique_ptr<IBackendVoice>& spare = VoicePool::HeaderOf(&vox)->m_backendSpare;
+  if (spare && m_backend.reuseVoice(*spare, vox, sampleRate, dynamicPitch))
+    return std::move(spare);
+  return m_backend.allocateVoice(vox, sampleRate, dynamicPitch);
+}
+
 std::list<ObjToken<Voice>>::iterator Engine::_allocateVoice(const AudioGroup& group, GroupId groupId, double sampleRate,
-                                                            bool dynamicPitch, bool emitter, ObjToken<Studio> studio) {
-  auto it =
-      m_activeVoices.emplace(m_activeVoices.end(), MakeObj<Voice>(*this, group, groupId, m_nextVid++, emitter, studio));
-  m_activeVoices.back()->m_backendVoice = m_backend.allocateVoice(*m_activeVoices.back(), sampleRate, dynamicPitch);
-  m_activeVoices.back()->m_backendVoice->setChannelLevels(studio->getMaster().m_backendSubmix.get(), FullLevels, false);
-  m_activeVoices.back()->m_backendVoice->setChannelLevels(studio->getAuxA().m_backendSubmix.get(), FullLevels, false);
-  m_activeVoices.back()->m_backendVoice->setChannelLevels(studio->getAuxB().m_backendSubmix.get(), FullLevels, false);
+                                                            bool dynamicPitch, bool emitter, ObjToken<Studio> studio,
+                                                            uint8_t priority, uint8_t maxVoices, const void* limitTag) {
+  if (!_reserveVoice(priority, maxVoices, limitTag))
+    return m_activeVoices.end();
+
+  Voice* newVox = new (*m_voicePool) Voice(*this, group, groupId, m_nextVid, emitter, studio);
+  if (!newVox)
+    return m_activeVoices.end();
+  ++m_nextVid;
+  auto it = m_voicePool->linkVoice(m_activeVoices, ObjToken<Voice>(newVox));
+  Voice& vox = **it;
+  vox.m_priority = priority;
+  vox.m_limitTag = limitTag;
+  vox.m_startOffset = m_eventOffset;
+  vox.m_backendVoice = _bindBackendVoice(vox, sampleRate, dynamicPitch);
+  vox.m_backendVoice->setChannelLevels(studio->getMaster().m_backendSubmix.get(), FullLevels, false);
+  vox.m_backendVoice->setChannelLevels(studio->getAuxA().m_backendSubmix.get(), FullLevels, false);
+  vox.m_backendVoice->setChannelLevels(studio->getAuxB().m_backendSubmix.get(), FullLevels, false);
   return it;
 }
 
@@ -94,7 +176,7 @@ std::list<ObjToken<Voice>>::iterator Engine::_destroyVoice(std::list<ObjToken<Vo
   if ((*it)->m_destroyed)
     return m_activeVoices.begin();
   (*it)->_destroy();
-  return m_activeVoices.erase(it);
+  return m_voicePool->unlinkVoice(m_activeVoices, it);
 }
 
 std::list<ObjToken<Sequencer>>::iterator Engine::_destroySequencer(std::list<ObjToken<Sequencer>>::iterator it) {
@@ -138,18 +220,42 @@ void Engine::_bringOutYourDead() {
 }
 
 void Engine::_on5MsInterval(IBackendVoiceAllocator& engine, double dt) {
+  ProfileScope prof(m_cycleStats.m_intervalTime);
+  m_cycleStats.m_audioTime += dt;
+  m_commandQueue.drain(*this);
   m_channelSet = engine.getAvailableSet();
   if (m_midiReader)
     m_midiReader->pumpReader(dt);
   for (ObjToken<Sequencer>& seq : m_activeSequencers)
     seq->advance(dt);
+  m_eventOffset = 0.0;
   for (ObjToken<Emitter>& emitter : m_activeEmitters)
     emitter->_update();
   for (ObjToken<Listener>& listener : m_activeListeners)
     listener->m_dirty = false;
 }
 
+void Engine::_publishCycleStats() {
+  /* Per-voice times are reduced here so concurrently rendered voices never share a counter */
+  EngineCycleStats& stats = m_cycleStats;
+  for (ObjToken<Voice>& vox : m_activeVoices) {
+    vox->_visitVoices([&stats](Voice& v) {
+      stats.m_preSupply.add(v.m_preSupplyTime);
+      stats.m_supply.add(v.m_supplyTime);
+      stats.m_route.add(v.m_routeTime);
+      v.m_preSupplyTime = v.m_supplyTime = v.m_routeTime = 0.0;
+      ++stats.m_numVoices;
+    });
+  }
+  stats.m_numSequencers = uint32_t(m_activeSequencers.size());
+  stats.m_numEmitters = uint32_t(m_activeEmitters.size());
+  stats.m_cycle = m_cycleIndex++;
+  m_profiler.publish(stats);
+  stats = {};
+}
+
 void Engine::_onPumpCycleComplete(IBackendVoiceAllocator& engine) {
+  _publishCycleStats();
   _bringOutYourDead();
 
   /* Determine lowest available free vid */
@@ -192,7 +298,7 @@ void Engine::removeAudioGroup(const AudioGroupData& data) {
     Voice* vox = it->get();
     if (&vox->getAudioGroup() == grp) {
       vox->_destroy();
-      it = m_activeVoices.erase(it);
+      it = m_voicePool->unlinkVoice(m_activeVoices, it);
       continue;
     }
     ++it;
@@ -218,6 +324,8 @@ void Engine::removeAudioGroup(const AudioGroupData& data) {
     ++it;
   }
 
+  m_sampleCache.purgeGroup(*grp);
+
   /* teardown SFX index for contained objects */
   for (const auto& pair : grp->getProj().sfxGroups()) {
     const SFXGroupIndex& sfxGroup = *pair.second;
@@ -243,8 +351,10 @@ ObjToken<Voice> Engine::fxStart(SFXId sfxId, float vol, float pan, ObjToken<Stud
   if (!grp)
     return {};
 
-  std::list<ObjToken<Voice>>::iterator ret =
-      _allocateVoice(*grp, std::get<1>(search->second), NativeSampleRate, true, false, smx);
+  std::list<ObjToken<Voice>>::iterator ret = _allocateVoice(*grp, std::get<1>(search->second), NativeSampleRate, true,
+                                                            false, smx, entry->priority, entry->maxVoices, entry);
+  if (ret == m_activeVoices.end())
+    return {};
 
   if (!(*ret)->loadPageObject(entry->objId, 1000.f, entry->defKey, entry->defVel, 0)) {
     _destroyVoice(ret);
@@ -265,9 +375,12 @@ ObjToken<Voice> Engine::fxStart(const AudioGroup* group, GroupId groupId, SFXId
   if (sfxIdx) {
     auto search = sfxIdx->m_sfxEntries.find(sfxId);
     if (search != sfxIdx->m_sfxEntries.cend()) {
-      std::list<ObjToken<Voice>>::iterator ret = _allocateVoice(*group, groupId, NativeSampleRate, true, false, smx);
-
       auto& entry = search->second;
+      std::list<ObjToken<Voice>>::iterator ret = _allocateVoice(*group, groupId, NativeSampleRate, true, false, smx,
+                                                                entry.priority, entry.maxVoices, &entry);
+      if (ret == m_activeVoices.end())
+        return {};
+
       if (!(*ret)->loadPageObject(entry.objId, 1000.f, entry.defKey, entry.defVel, 0)) {
         _destroyVoice(ret);
         return {};
@@ -291,6 +404,8 @@ ObjToken<Voice> Engine::macroStart(const AudioGroup* group, SoundMacroId id, uin
     return {};
 
   std::list<ObjToken<Voice>>::iterator ret = _allocateVoice(*group, {}, NativeSampleRate, true, false, smx);
+  if (ret == m_activeVoices.end())
+    return {};
 
   if (!(*ret)->loadMacroObject(id, 0, 1000.f, key, vel, mod)) {
     _destroyVoice(ret);
@@ -309,6 +424,8 @@ ObjToken<Voice> Engine::macroStart(const AudioGroup* group, const SoundMacro* ma
     return {};
 
   std::list<ObjToken<Voice>>::iterator ret = _allocateVoice(*group, {}, NativeSampleRate, true, false, smx);
+  if (ret == m_activeVoices.end())
+    return {};
 
   if (!(*ret)->loadMacroObject(macro, 0, 1000.f, key, vel, mod)) {
     _destroyVoice(ret);
@@ -327,6 +444,8 @@ ObjToken<Voice> Engine::pageObjectStart(const AudioGroup* group, ObjectId id, ui
     return {};
 
   std::list<ObjToken<Voice>>::iterator ret = _allocateVoice(*group, {}, NativeSampleRate, true, false, smx);
+  if (ret == m_activeVoices.end())
+    return {};
 
   if (!(*ret)->loadPageObject(id, 1000.f, key, vel, mod)) {
     _destroyVoice(ret);
@@ -348,8 +467,10 @@ ObjToken<Emitter> Engine::addEmitter(const float* pos, const float* dir, float m
   if (!grp)
     return {};
 
-  std::list<ObjToken<Voice>>::iterator vox =
-      _allocateVoice(*grp, std::get<1>(search->second), NativeSampleRate, true, true, smx);
+  std::list<ObjToken<Voice>>::iterator vox = _allocateVoice(*grp, std::get<1>(search->second), NativeSampleRate, true,
+                                                            true, smx, entry->priority, entry->maxVoices, entry);
+  if (vox == m_activeVoices.end())
+    return {};
 
   if (!(*vox)->loadPageObject(entry->objId, 1000.f, entry->defKey, entry->defVel, 0)) {
     _destroyVoice(vox);
@@ -0,0 +1,55 @@
+#include "amuse/EngineStats.hpp"
+
+#include <algorithm>
+
+namespace amuse {
+
+static EngineStatsPercentiles ComputePercentiles(const std::array<float, EngineStatsSnapshot::HistorySize>& history,
+                                                 size_t count) {
+  EngineStatsPercentiles ret;
+  if (!count)
+    return ret;
+
+  std::array<float, EngineStatsSnapshot::HistorySize> sorted;
+  std::copy(history.begin(), history.begin() + count, sorted.begin());
+  auto rank = [&](float p) {
+    const auto idx = std::min(size_t(p * float(count)), count - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + idx, sorted.begin() + count);
+    return sorted[idx];
+  };
+  ret.m_p50 = rank(0.5f);
+  ret.m_p90 = rank(0.9f);
+  ret.m_p99 = rank(0.99f);
+  ret.m_max = *std::max_element(sorted.begin(), sorted.begin() + count);
+  return ret;
+}
+
+EngineStatsPercentiles EngineStatsSnapshot::cpuTimePercentiles() const {
+  return ComputePercentiles(m_cpuHistory, m_historyCount);
+}
+
+EngineStatsPercentiles EngineStatsSnapshot::loadPercentiles() const {
+  return ComputePercentiles(m_loadHistory, m_historyCount);
+}
+
+void EngineProfiler::publish(const EngineCycleStats& stats) {
+  m_cpuRing[m_ringPos] = float(stats.cpuTime());
+  m_loadRing[m_ringPos] = float(stats.load());
+  m_ringPos = (m_ringPos + 1) % EngineStatsSnapshot::HistorySize;
+  m_ringCount = std::min(m_ringCount + 1, EngineStatsSnapshot::HistorySize);
+
+  EngineStatsSnapshot& back = m_buffers[m_back];
+  back.m_last = stats;
+  back.m_historyCount = m_ringCount;
+  back.m_cpuHistory = m_cpuRing;
+  back.m_loadHistory = m_loadRing;
+  m_back = m_middle.exchange(uint8_t(m_back | FreshBit), std::memory_order_acq_rel) & IndexMask;
+}
+
+const EngineStatsSnapshot& EngineProfiler::snapshot() {
+  if (m_middle.load(std::memory_order_relaxed) & FreshBit)
+    m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & IndexMask;
+  return m_buffers[m_front];
+}
+
+} // namespace amuse
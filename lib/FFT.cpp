@@ -0,0 +1,217 @@
+#include "amuse/FFT.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FFT_X86 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define FFT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace amuse {
+
+namespace {
+
+constexpr double Pi = 3.14159265358979323846;
+
+/** Four floats processed together */
+#if FFT_X86
+using Quad = __m128;
+Quad Load(const float* p) { return _mm_loadu_ps(p); }
+void Store(float* p, Quad v) { _mm_storeu_ps(p, v); }
+Quad Add(Quad a, Quad b) { return _mm_add_ps(a, b); }
+Quad Sub(Quad a, Quad b) { return _mm_sub_ps(a, b); }
+Quad Mul(Quad a, Quad b) { return _mm_mul_ps(a, b); }
+#elif FFT_NEON
+using Quad = float32x4_t;
+Quad Load(const float* p) { return vld1q_f32(p); }
+void Store(float* p, Quad v) { vst1q_f32(p, v); }
+Quad Add(Quad a, Quad b) { return vaddq_f32(a, b); }
+Quad Sub(Quad a, Quad b) { return vsubq_f32(a, b); }
+Quad Mul(Quad a, Quad b) { return vmulq_f32(a, b); }
+#else
+struct Quad {
+  float v[4];
+};
+Quad Load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+void Store(float* p, Quad q) { std::copy(q.v, q.v + 4, p); }
+Quad Add(Quad a, Quad b) { return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+Quad Sub(Quad a, Quad b) { return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}}; }
+Quad Mul(Quad a, Quad b) { return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}}; }
+#endif
+
+} // anonymous namespace
+
+FFT::FFT(size_t size) : m_size(size) {
+  const size_t half = size / 2;
+
+  unsigned bits = 0;
+  while ((size_t(1) << bits) < half)
+    ++bits;
+  m_bitRev.resize(half);
+  for (size_t i = 0; i < half; ++i) {
+    uint32_t rev = 0;
+    for (unsigned b = 0; b < bits; ++b)
+      rev |= ((i >> b) & 1) << (bits - 1 - b);
+    m_bitRev[i] = rev;
+  }
+
+  m_twRe.resize(half);
+  m_twIm.resize(half);
+  for (size_t h = 1; h < half; h *= 2) {
+    for (size_t j = 0; j < h; ++j) {
+      const double angle = -Pi * double(j) / double(h);
+      m_twRe[h - 1 + j] = float(std::cos(angle));
+      m_twIm[h - 1 + j] = float(std::sin(angle));
+    }
+  }
+
+  m_postRe.resize(half / 2 + 1);
+  m_postIm.resize(half / 2 + 1);
+  for (size_t k = 0; k <= half / 2; ++k) {
+    const double angle = -2.0 * Pi * double(k) / double(size);
+    m_postRe[k] = float(std::cos(angle));
+    m_postIm[k] = float(std::sin(angle));
+  }
+}
+
+void FFT::_complexTransform(float* re, float* im) const {
+  const size_t n = m_size / 2;
+  for (size_t i = 0; i < n; ++i) {
+    const size_t j = m_bitRev[i];
+    if (i < j) {
+      std::swap(re[i], re[j]);
+      std::swap(im[i], im[j]);
+    }
+  }
+
+  /* Radix-2 decimation in time; the short first stages run scalar, the rest four butterflies at a time */
+  size_t h = 1;
+  for (; h < std::min(n, size_t(4)); h *= 2) {
+    const float* twRe = &m_twRe[h - 1];
+    const float* twIm = &m_twIm[h - 1];
+    for (size_t base = 0; base < n; base += 2 * h) {
+      for (size_t j = 0; j < h; ++j) {
+        const size_t a = base + j;
+        const size_t b = a + h;
+        const float tr = twRe[j] * re[b] - twIm[j] * im[b];
+        const float ti = twRe[j] * im[b] + twIm[j] * re[b];
+        re[b] = re[a] - tr;
+        im[b] = im[a] - ti;
+        re[a] += tr;
+        im[a] += ti;
+      }
+    }
+  }
+  for (; h < n; h *= 2) {
+    const float* twRe = &m_twRe[h - 1];
+    const float* twIm = &m_twIm[h - 1];
+    for (size_t base = 0; base < n; base += 2 * h) {
+      for (size_t j = 0; j < h; j += 4) {
+        float* aRe = re + base + j;
+        float* aIm = im + base + j;
+        float* bRe = aRe + h;
+        float* bIm = aIm + h;
+        const Quad wr = Load(twRe + j);
+        const Quad wi = Load(twIm + j);
+        const Quad br = Load(bRe);
+        const Quad bi = Load(bIm);
+        const Quad tr = Sub(Mul(wr, br), Mul(wi, bi));
+        const Quad ti = Add(Mul(wr, bi), Mul(wi, br));
+        const Quad ar = Load(aRe);
+        const Quad ai = Load(aIm);
+        Store(bRe, Sub(ar, tr));
+        Store(bIm, Sub(ai, ti));
+        Store(aRe, Add(ar, tr));
+        Store(aIm, Add(ai, ti));
+      }
+    }
+  }
+}
+
+void FFT::forward(const float* in, float* re, float* im) const {
+  const size_t n = m_size / 2;
+
+  /* Even samples as the real part, odd as the imaginary part of a half-size complex signal */
+  for (size_t i = 0; i < n; ++i) {
+    re[i] = in[2 * i];
+    im[i] = in[2 * i + 1];
+  }
+  _complexTransform(re, im);
+
+  /* Separate the even and odd spectra and combine them into bins [0, N/2] */
+  const float z0r = re[0];
+  const float z0i = im[0];
+  re[0] = z0r + z0i;
+  im[0] = 0.f;
+  re[n] = z0r - z0i;
+  im[n] = 0.f;
+  for (size_t k = 1; k <= n / 2; ++k) {
+    const size_t mk = n - k;
+    const float zkr = re[k], zki = im[k];
+    const float zmr = re[mk], zmi = im[mk];
+    const float er = 0.5f * (zkr + zmr);
+    const float ei = 0.5f * (zki - zmi);
+    const float odr = 0.5f * (zki + zmi);
+    const float odi = -0.5f * (zkr - zmr);
+    const float tr = m_postRe[k] * odr - m_postIm[k] * odi;
+    const float ti = m_postRe[k] * odi + m_postIm[k] * odr;
+    re[k] = er + tr;
+    im[k] = ei + ti;
+    re[mk] = er - tr;
+    im[mk] = ti - ei;
+  }
+  std::fill(re + n + 1, re + spectrumStride(), 0.f);
+  std::fill(im + n + 1, im + spectrumStride(), 0.f);
+}
+
+void FFT::inverse(float* re, float* im, float* out) const {
+  const size_t n = m_size / 2;
+
+  /* Repack bins [0, N/2] as the half-size spectrum of even + i * odd samples */
+  const float x0 = re[0];
+  const float xn = re[n];
+  re[0] = x0 + xn;
+  im[0] = x0 - xn;
+  for (size_t k = 1; k <= n / 2; ++k) {
+    const size_t mk = n - k;
+    const float xkr = re[k], xki = im[k];
+    const float xmr = re[mk], xmi = im[mk];
+    const float er = xkr + xmr;
+    const float ei = xki - xmi;
+    const float dr = xkr - xmr;
+    const float di = xki + xmi;
+    const float odr = dr * m_postRe[k] + di * m_postIm[k];
+    const float odi = di * m_postRe[k] - dr * m_postIm[k];
+    re[k] = er - odi;
+    im[k] = ei + odr;
+    re[mk] = er + odi;
+    im[mk] = odr - ei;
+  }
+
+  /* Inverse by conjugation around the forward transform */
+  for (size_t i = 0; i < n; ++i)
+    im[i] = -im[i];
+  _complexTransform(re, im);
+  for (size_t i = 0; i < n; ++i) {
+    out[2 * i] = re[i];
+    out[2 * i + 1] = -im[i];
+  }
+}
+
+void FFT::MultiplyAccumulate(float* accRe, float* accIm, const float* aRe, const float* aIm, const float* bRe,
+                             const float* bIm, size_t count) {
+  for (size_t i = 0; i < count; i += 4) {
+    const Quad ar = Load(aRe + i);
+    const Quad ai = Load(aIm + i);
+    const Quad br = Load(bRe + i);
+    const Quad bi = Load(bIm + i);
+    Store(accRe + i, Add(Load(accRe + i), Sub(Mul(ar, br), Mul(ai, bi))));
+    Store(accIm + i, Add(Load(accIm + i), Add(Mul(ar, bi), Mul(ai, br))));
+  }
+}
+
+} // namespace amuse
@@ -0,0 +1,73 @@
+#include "amuse/MIDIEventQueue.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace amuse {
+
+static size_t NextPowerOfTwo(size_t val) {
+  size_t ret = 2;
+  while (ret < val)
+    ret <<= 1;
+  return ret;
+}
+
+MIDIEventQueue::MIDIEventQueue(size_t eventCapacity, size_t arenaCapacity)
+: m_events(std::make_unique<MIDIEvent[]>(NextPowerOfTwo(eventCapacity)))
+, m_eventMask(NextPowerOfTwo(eventCapacity) - 1)
+, m_arena(std::make_unique<uint8_t[]>(NextPowerOfTwo(arenaCapacity)))
+, m_arenaMask(NextPowerOfTwo(arenaCapacity) - 1) {}
+
+bool MIDIEventQueue::push(double time, const uint8_t* data, size_t len) {
+  const size_t head = m_head.load(std::memory_order_relaxed);
+  if (head - m_tail.load(std::memory_order_acquire) > m_eventMask)
+    return false;
+
+  MIDIEvent& ev = m_events[head & m_eventMask];
+  if (len <= MIDIEvent::InlineBytes) {
+    std::memcpy(ev.m_bytes, data, len);
+  } else {
+    /* Spill to the arena, wrapping around its end */
+    if (len > m_arenaMask + 1 - (m_arenaHead - m_arenaTail.load(std::memory_order_acquire)))
+      return false;
+    const size_t start = m_arenaHead & m_arenaMask;
+    const size_t first = std::min(len, m_arenaMask + 1 - start);
+    std::memcpy(&m_arena[start], data, first);
+    std::memcpy(&m_arena[0], data + first, len - first);
+    ev.m_arenaPos = m_arenaHead;
+    m_arenaHead += len;
+  }
+  ev.m_time = time;
+  ev.m_len = uint32_t(len);
+
+  m_head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+const MIDIEvent* MIDIEventQueue::front() const {
+  const size_t tail = m_tail.load(std::memory_order_relaxed);
+  if (tail == m_head.load(std::memory_order_acquire))
+    return nullptr;
+  return &m_events[tail & m_eventMask];
+}
+
+void MIDIEventQueue::copyBytes(const MIDIEvent& ev, uint8_t* out) const {
+  if (ev.m_len <= MIDIEvent::InlineBytes) {
+    std::memcpy(out, ev.m_bytes, ev.m_len);
+    return;
+  }
+  const size_t start = ev.m_arenaPos & m_arenaMask;
+  const size_t first = std::min(size_t(ev.m_len), m_arenaMask + 1 - start);
+  std::memcpy(out, &m_arena[start], first);
+  std::memcpy(out + first, &m_arena[0], ev.m_len - first);
+}
+
+void MIDIEventQueue::pop() {
+  const size_t tail = m_tail.load(std::memory_order_relaxed);
+  const MIDIEvent& ev = m_events[tail & m_eventMask];
+  if (ev.m_len > MIDIEvent::InlineBytes)
+    m_arenaTail.store(ev.m_arenaPos + ev.m_len, std::memory_order_release);
+  m_tail.store(tail + 1, std::memory_order_release);
+}
+
+} // namespace amuse
@@ -3,6 +3,12 @@
 #include <cstdint>
 #include <cstring>
 
+#if __SSE2__ || _M_X64
+#include <emmintrin.h>
+#elif __ARM_NEON
+#include <arm_neon.h>
+#endif
+
 /* Acknowledgements:
  * SubDrag for N64 Sound Tool (http://www.goldeneyevault.com/viewfile.php?id=212)
  * Bobby Smiles for MusyX codec research
@@ -131,3 +137,145 @@ unsigned N64MusyXDecompressFrameRanged(int16_t* out, const uint8_t* in, const in
   memmove(out, final + firstSample, samples * 2);
   return samples;
 }
+
+#pragma mark Matrix Decoder
+
+N64MusyXPredictor::N64MusyXPredictor(const int16_t coefs[8][2][8]) {
+  for (unsigned b = 0; b < 8; ++b) {
+    const int16_t* book1 = coefs[b][0];
+    const int16_t* book2 = coefs[b][1];
+    for (unsigned row = 0; row < 8; ++row) {
+      /* Same terms as adpcm_decode_upto_8_samples, laid out as one matrix row */
+      int16_t m[10] = {book1[row], book2[row]};
+      for (unsigned j = 0; j < 8; ++j)
+        m[2 + j] = (j < row) ? book2[row - 1 - j] : (j == row) ? int16_t(2048) : int16_t(0);
+      for (unsigned p = 0; p < 5; ++p) {
+        m_mtx[b][p][row / 4][(row % 4) * 2] = m[p * 2];
+        m_mtx[b][p][row / 4][(row % 4) * 2 + 1] = m[p * 2 + 1];
+      }
+    }
+  }
+}
+
+#if __SSE2__ || _M_X64
+static void adpcm_get_predicted_frame_mtx(int16_t* dst, const unsigned char* src, const unsigned char* nibbles,
+                                          unsigned rshift) {
+  /* dst must hold 34 samples; the last two are scratch */
+  dst[0] = (src[0] << 8) | src[1];
+  dst[1] = (src[2] << 8) | src[3];
+
+  const __m128i bytes = _mm_srli_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(nibbles)), 1);
+  const __m128i shift = _mm_cvtsi32_si128(rshift);
+  const __m128i hiMask = _mm_set1_epi16(int16_t(0xf000));
+  const __m128i w0 = _mm_unpacklo_epi8(_mm_setzero_si128(), bytes);
+  const __m128i w1 = _mm_unpackhi_epi8(_mm_setzero_si128(), bytes);
+  const __m128i h0 = _mm_and_si128(w0, hiMask), l0 = _mm_slli_epi16(w0, 4);
+  const __m128i h1 = _mm_and_si128(w1, hiMask), l1 = _mm_slli_epi16(w1, 4);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2), _mm_sra_epi16(_mm_unpacklo_epi16(h0, l0), shift));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 10), _mm_sra_epi16(_mm_unpackhi_epi16(h0, l0), shift));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 18), _mm_sra_epi16(_mm_unpacklo_epi16(h1, l1), shift));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 26), _mm_sra_epi16(_mm_unpackhi_epi16(h1, l1), shift));
+}
+
+static void adpcm_decode_8_samples_mtx(int16_t* dst, const int16_t* src, const int16_t mtx[5][2][8],
+                                       const int16_t* last_samples) {
+  /* Broadcast each (even, odd) input pair and accumulate with pmaddwd */
+  const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+  const __m128i l = _mm_set1_epi32(int32_t(uint16_t(last_samples[0]) | (uint32_t(uint16_t(last_samples[1])) << 16)));
+  const __m128i* m = reinterpret_cast<const __m128i*>(mtx);
+  __m128i acc0 = _mm_madd_epi16(l, m[0]);
+  __m128i acc1 = _mm_madd_epi16(l, m[1]);
+  __m128i v = _mm_shuffle_epi32(s, 0x00);
+  acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(v, m[2]));
+  acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(v, m[3]));
+  v = _mm_shuffle_epi32(s, 0x55);
+  acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(v, m[4]));
+  acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(v, m[5]));
+  v = _mm_shuffle_epi32(s, 0xaa);
+  acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(v, m[6]));
+  acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(v, m[7]));
+  v = _mm_shuffle_epi32(s, 0xff);
+  acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(v, m[8]));
+  acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(v, m[9]));
+
+  /* Saturating pack performs the clamp */
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                   _mm_packs_epi32(_mm_srai_epi32(acc0, 11), _mm_srai_epi32(acc1, 11)));
+}
+#else
+static void adpcm_get_predicted_frame_mtx(int16_t* dst, const unsigned char* src, const unsigned char* nibbles,
+                                          unsigned rshift) {
+  adpcm_get_predicted_frame(dst, src, nibbles, rshift);
+}
+
+#if __ARM_NEON
+static void adpcm_decode_8_samples_mtx(int16_t* dst, const int16_t* src, const int16_t mtx[5][2][8],
+                                       const int16_t* last_samples) {
+  const int16_t v[10] = {last_samples[0], last_samples[1], src[0], src[1], src[2],
+                         src[3],          src[4],          src[5], src[6], src[7]};
+  int32x4_t acc0 = vdupq_n_s32(0);
+  int32x4_t acc1 = vdupq_n_s32(0);
+  for (unsigned p = 0; p < 5; ++p) {
+    const int16x4x2_t c0 = vld2_s16(mtx[p][0]);
+    const int16x4x2_t c1 = vld2_s16(mtx[p][1]);
+    acc0 = vmlal_n_s16(vmlal_n_s16(acc0, c0.val[0], v[p * 2]), c0.val[1], v[p * 2 + 1]);
+    acc1 = vmlal_n_s16(vmlal_n_s16(acc1, c1.val[0], v[p * 2]), c1.val[1], v[p * 2 + 1]);
+  }
+  vst1q_s16(dst, vcombine_s16(vqmovn_s32(vshrq_n_s32(acc0, 11)), vqmovn_s32(vshrq_n_s32(acc1, 11))));
+}
+#else
+static void adpcm_decode_8_samples_mtx(int16_t* dst, const int16_t* src, const int16_t mtx[5][2][8],
+                                       const int16_t* last_samples) {
+  const int16_t v[10] = {last_samples[0], last_samples[1], src[0], src[1], src[2],
+                         src[3],          src[4],          src[5], src[6], src[7]};
+  for (unsigned row = 0; row < 8; ++row) {
+    const int16_t* m = mtx[0][row / 4] + (row % 4) * 2;
+    int accu = 0;
+    for (unsigned p = 0; p < 5; ++p)
+      accu += m[p * 16] * v[p * 2] + m[p * 16 + 1] * v[p * 2 + 1];
+    dst[row] = N64MusyXSampClamp(accu >> 11);
+  }
+}
+#endif
+#endif
+
+static void adpcm_decode_half_frame_mtx(int16_t* out, const uint8_t* src, const uint8_t* nibbles,
+                                        const N64MusyXPredictor& pred) {
+  /* Each group writes 8 samples; the first group overlaps the next and is overwritten by it */
+  int16_t frame[34];
+
+  unsigned char c2 = nibbles[0];
+  c2 = c2 % 0x80;
+
+  const int16_t(*mtx)[2][8] = pred.m_mtx[(c2 & 0xf0) >> 4];
+  adpcm_get_predicted_frame_mtx(frame, src, nibbles, c2 & 0x0f);
+
+  out[0] = frame[0];
+  out[1] = frame[1];
+  adpcm_decode_8_samples_mtx(out + 2, frame + 2, mtx, out + 0);
+  adpcm_decode_8_samples_mtx(out + 8, frame + 8, mtx, out + 6);
+  adpcm_decode_8_samples_mtx(out + 16, frame + 16, mtx, out + 14);
+  adpcm_decode_8_samples_mtx(out + 24, frame + 24, mtx, out + 22);
+}
+
+unsigned N64MusyXDecompressFrame(int16_t* out, const uint8_t* in, const N64MusyXPredictor& pred, unsigned lastSample) {
+  int16_t final[64];
+  adpcm_decode_half_frame_mtx(final, &in[0x0], &in[0x8], pred);
+  adpcm_decode_half_frame_mtx(final + 32, &in[0x4], &in[0x18], pred);
+
+  unsigned samples = (lastSample < 64) ? lastSample : 64;
+  memmove(out, final, samples * 2);
+  return samples;
+}
+
+unsigned N64MusyXDecompressFrameRanged(int16_t* out, const uint8_t* in, const N64MusyXPredictor& pred,
+                                       unsigned firstSample, unsigned lastSample) {
+  int16_t final[64];
+  adpcm_decode_half_frame_mtx(final, &in[0x0], &in[0x8], pred);
+  adpcm_decode_half_frame_mtx(final + 32, &in[0x4], &in[0x18], pred);
+
+  unsigned procSamples = (firstSample + lastSample < 64) ? firstSample + lastSample : 64;
+  unsigned samples = procSamples - firstSample;
+  memmove(out, final + firstSample, samples * 2);
+  return samples;
+}
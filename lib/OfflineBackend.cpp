@@ -0,0 +1,300 @@
+#include "amuse/OfflineBackend.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "amuse/Engine.hpp"
+#include "amuse/Submix.hpp"
+#include "amuse/Voice.hpp"
+
+namespace amuse {
+
+OfflineBackendVoice::OfflineBackendVoice(OfflineBackendVoiceAllocator& parent, Voice& clientVox, double sampleRate,
+                                         bool dynamicPitch)
+: m_parent(parent), m_clientVox(&clientVox), m_sampleRate(sampleRate), m_dynamicPitch(dynamicPitch) {
+  m_parent.m_voices.push_back(this);
+}
+
+OfflineBackendVoice::~OfflineBackendVoice() {
+  /* Leave a hole so indices held by an in-progress block stay valid */
+  auto search = std::find(m_parent.m_voices.begin(), m_parent.m_voices.end(), this);
+  if (search != m_parent.m_voices.end())
+    *search = nullptr;
+}
+
+void OfflineBackendVoice::resetSampleRate(double sampleRate) {
+  m_sampleRate = sampleRate;
+  m_resampler.reset();
+}
+
+void OfflineBackendVoice::resetChannelLevels() {
+  for (Binding& binding : m_bindings)
+    m_routedSpare.push_back(std::move(binding.m_routed));
+  m_bindings.clear();
+}
+
+void OfflineBackendVoice::setChannelLevels(IBackendSubmix* submix, const std::array<float, 8>& coefs, bool slew) {
+  auto* smx = static_cast<OfflineBackendSubmix*>(submix);
+  auto search = std::find_if(m_bindings.begin(), m_bindings.end(),
+                             [smx](const Binding& binding) { return binding.m_submix == smx; });
+  if (search == m_bindings.end()) {
+    /* New bindings ramp up from silence like any other slewed change */
+    search = m_bindings.emplace(m_bindings.end());
+    search->m_submix = smx;
+    if (!m_routedSpare.empty()) {
+      search->m_routed = std::move(m_routedSpare.back());
+      m_routedSpare.pop_back();
+    }
+  }
+  search->m_targetCoefs = coefs;
+  search->m_slewing = slew;
+  if (!slew)
+    search->m_curCoefs = coefs;
+}
+
+void OfflineBackendVoice::setPitchRatio(double ratio, bool) {
+  if (m_dynamicPitch)
+    m_pitchRatio = ratio;
+}
+
+void OfflineBackendVoice::start() { m_running = true; }
+
+void OfflineBackendVoice::stop() { m_running = false; }
+
+void OfflineBackendVoice::_render(size_t frames, double dt) {
+  if (const Engine* engine = m_parent.m_cbInterface) {
+    const ResamplerQuality quality = engine->getResamplerQuality(m_clientVox->getPriority());
+    if (quality != m_resampler.getQuality())
+      m_resampler.setQuality(quality);
+  }
+
+  /* Pull enough voice-rate samples to interpolate every output frame of this block */
+  const double step = m_sampleRate * m_pitchRatio / m_parent.m_sampleRate;
+  if (const size_t fetch = m_resampler.inputNeeded(frames, step)) {
+    m_decodeBuf.resize(fetch);
+    m_clientVox->supplyAudio(fetch, m_decodeBuf.data());
+    m_resampler.pushInput(m_decodeBuf.data(), fetch);
+  }
+
+  m_outBuf.resize(frames);
+  m_resampler.process(m_outBuf.data(), frames, step);
+
+  for (Binding& binding : m_bindings) {
+    binding.m_routed.resize(frames);
+    m_clientVox->routeAudio(frames, dt, binding.m_submix->m_busId, m_outBuf.data(), binding.m_routed.data());
+  }
+}
+
+void OfflineBackendVoice::_mix(size_t frames) {
+  const ChannelMap& chanMap = m_parent.m_chanMap;
+  const size_t channels = chanMap.m_channelCount;
+  for (Binding& binding : m_bindings) {
+    float* out = binding.m_submix->m_buf.data();
+    for (size_t c = 0; c < channels; ++c) {
+      const auto chan = size_t(chanMap.m_channels[c]);
+      if (chan >= NumChannels)
+        continue;
+      const float start = binding.m_curCoefs[chan];
+      const float end = binding.m_targetCoefs[chan];
+      if (binding.m_slewing && start != end) {
+        const float slope = (end - start) / float(frames);
+        for (size_t f = 0; f < frames; ++f)
+          out[f * channels + c] += binding.m_routed[f] * (start + slope * float(f + 1));
+      } else if (end != 0.f) {
+        for (size_t f = 0; f < frames; ++f)
+          out[f * channels + c] += binding.m_routed[f] * end;
+      }
+    }
+    binding.m_curCoefs = binding.m_targetCoefs;
+    binding.m_slewing = false;
+  }
+}
+
+OfflineBackendSubmix::OfflineBackendSubmix(OfflineBackendVoiceAllocator& parent, Submix& clientSmx, bool mainOut,
+                                           int busId)
+: m_parent(parent), m_clientSmx(clientSmx), m_mainOut(mainOut), m_busId(busId) {
+  m_parent.m_submixes.push_back(this);
+}
+
+OfflineBackendSubmix::~OfflineBackendSubmix() {
+  for (OfflineBackendSubmix*& smx : m_parent.m_submixes) {
+    if (smx == this) {
+      smx = nullptr;
+    } else if (smx) {
+      auto& sends = smx->m_sends;
+      sends.erase(std::remove_if(sends.begin(), sends.end(), [this](const auto& send) { return send.first == this; }),
+                  sends.end());
+    }
+  }
+}
+
+void OfflineBackendSubmix::setSendLevel(IBackendSubmix* submix, float level, bool) {
+  auto* smx = static_cast<OfflineBackendSubmix*>(submix);
+  auto search = std::find_if(m_sends.begin(), m_sends.end(), [smx](const auto& send) { return send.first == smx; });
+  if (search != m_sends.end())
+    search->second = level;
+  else
+    m_sends.emplace_back(smx, level);
+}
+
+double OfflineBackendSubmix::getSampleRate() const { return m_parent.m_sampleRate; }
+
+SubmixFormat OfflineBackendSubmix::getSampleFormat() const { return SubmixFormat::Float; }
+
+static ChannelMap ChannelMapForSet(AudioChannelSet set) {
+  ChannelMap ret;
+  auto add = [&ret](AudioChannel chan) { ret.m_channels[ret.m_channelCount++] = chan; };
+  add(AudioChannel::FrontLeft);
+  add(AudioChannel::FrontRight);
+  switch (set) {
+  case AudioChannelSet::Quad:
+    add(AudioChannel::RearLeft);
+    add(AudioChannel::RearRight);
+    break;
+  case AudioChannelSet::Surround51:
+    add(AudioChannel::FrontCenter);
+    add(AudioChannel::LFE);
+    add(AudioChannel::RearLeft);
+    add(AudioChannel::RearRight);
+    break;
+  case AudioChannelSet::Surround71:
+    add(AudioChannel::FrontCenter);
+    add(AudioChannel::LFE);
+    add(AudioChannel::RearLeft);
+    add(AudioChannel::RearRight);
+    add(AudioChannel::SideLeft);
+    add(AudioChannel::SideRight);
+    break;
+  default:
+    break;
+  }
+  return ret;
+}
+
+OfflineBackendVoiceAllocator::OfflineBackendVoiceAllocator(double sampleRate, AudioChannelSet channelSet)
+: m_sampleRate(sampleRate)
+, m_channelSet(channelSet == AudioChannelSet::Unknown ? AudioChannelSet::Stereo : channelSet)
+, m_chanMap(ChannelMapForSet(m_channelSet))
+, m_5msFrames(std::max(size_t(sampleRate * 5.0 / 1000.0), size_t(1)))
+, m_blockBuf(m_5msFrames * m_chanMap.m_channelCount)
+, m_blockPos(m_5msFrames) {}
+
+std::unique_ptr<IBackendVoice> OfflineBackendVoiceAllocator::allocateVoice(Voice& clientVox, double sampleRate,
+                                                                           bool dynamicPitch) {
+  return std::make_unique<OfflineBackendVoice>(*this, clientVox, sampleRate, dynamicPitch);
+}
+
+bool OfflineBackendVoiceAllocator::releaseVoice(IBackendVoice& voice) {
+  auto& vox = static_cast<OfflineBackendVoice&>(voice);
+  vox.stop();
+  vox.m_clientVox = nullptr;
+  return true;
+}
+
+bool OfflineBackendVoiceAllocator::reuseVoice(IBackendVoice& voice, Voice& clientVox, double sampleRate,
+                                              bool dynamicPitch) {
+  auto& vox = static_cast<OfflineBackendVoice&>(voice);
+  vox.m_clientVox = &clientVox;
+  vox.m_dynamicPitch = dynamicPitch;
+  vox.m_pitchRatio = 1.0;
+  vox.resetSampleRate(sampleRate);
+  vox.resetChannelLevels();
+
+  /* Move to the end so mixing stays in allocation order; m_voices keeps its capacity across blocks */
+  auto search = std::find(m_voices.begin(), m_voices.end(), &vox);
+  if (search != m_voices.end())
+    *search = nullptr;
+  m_voices.push_back(&vox);
+  return true;
+}
+
+std::unique_ptr<IBackendSubmix> OfflineBackendVoiceAllocator::allocateSubmix(Submix& clientSmx, bool mainOut,
+                                                                             int busId) {
+  return std::make_unique<OfflineBackendSubmix>(*this, clientSmx, mainOut, busId);
+}
+
+std::vector<std::pair<std::string, std::string>> OfflineBackendVoiceAllocator::enumerateMIDIDevices() { return {}; }
+
+std::unique_ptr<IMIDIReader> OfflineBackendVoiceAllocator::allocateMIDIReader(Engine&) { return {}; }
+
+void OfflineBackendVoiceAllocator::setCallbackInterface(Engine* engine) { m_cbInterface = engine; }
+
+AudioChannelSet OfflineBackendVoiceAllocator::getAvailableSet() { return m_channelSet; }
+
+void OfflineBackendVoiceAllocator::setVolume(float vol) { m_volume = vol; }
+
+void OfflineBackendVoiceAllocator::_pumpBlock() {
+  const size_t frames = m_5msFrames;
+  const size_t channels = m_chanMap.m_channelCount;
+  const double dt = double(frames) / m_sampleRate;
+
+  m_voices.erase(std::remove(m_voices.begin(), m_voices.end(), nullptr), m_voices.end());
+  m_submixes.erase(std::remove(m_submixes.begin(), m_submixes.end(), nullptr), m_submixes.end());
+
+  if (m_cbInterface)
+    m_cbInterface->_on5MsInterval(*this, dt);
+
+  /* Macro processing may start or destroy voices, so it runs serially over a fixed snapshot.
+   * Voices allocated along the way begin rendering with the next block. */
+  const size_t numVoices = m_voices.size();
+  for (size_t i = 0; i < numVoices; ++i)
+    if (OfflineBackendVoice* vox = m_voices[i]; vox && vox->m_running)
+      vox->m_clientVox->preSupplyAudio(dt);
+
+  m_blockVoices.clear();
+  for (size_t i = 0; i < numVoices; ++i)
+    if (OfflineBackendVoice* vox = m_voices[i]; vox && vox->m_running)
+      m_blockVoices.push_back(vox);
+
+  /* Decode, resample and bus routing touch only per-voice state */
+  RenderPool* pool = m_cbInterface ? m_cbInterface->getRenderPool() : nullptr;
+  if (pool) {
+    pool->parallelFor(m_blockVoices.size(), [&](size_t i) { m_blockVoices[i]->_render(frames, dt); });
+  } else {
+    for (OfflineBackendVoice* vox : m_blockVoices)
+      vox->_render(frames, dt);
+  }
+
+  /* Accumulate in allocation order so results do not depend on thread count */
+  for (OfflineBackendSubmix* smx : m_submixes)
+    smx->m_buf.assign(frames * channels, 0.f);
+  for (OfflineBackendVoice* vox : m_blockVoices)
+    vox->_mix(frames);
+
+  /* Later studios feed earlier ones (the default studio is created first) */
+  std::fill(m_blockBuf.begin(), m_blockBuf.end(), 0.f);
+  for (auto it = m_submixes.rbegin(); it != m_submixes.rend(); ++it) {
+    OfflineBackendSubmix& smx = **it;
+    if (smx.m_clientSmx.canApplyEffect())
+      smx.m_clientSmx.applyEffect(smx.m_buf.data(), frames, m_chanMap);
+    for (const auto& [target, level] : smx.m_sends)
+      for (size_t i = 0; i < smx.m_buf.size(); ++i)
+        target->m_buf[i] += smx.m_buf[i] * level;
+    if (smx.m_mainOut)
+      for (size_t i = 0; i < smx.m_buf.size(); ++i)
+        m_blockBuf[i] += smx.m_buf[i];
+  }
+
+  for (float& samp : m_blockBuf)
+    samp *= m_volume;
+}
+
+void OfflineBackendVoiceAllocator::pumpAndMix(float* out, size_t frames) {
+  const size_t channels = m_chanMap.m_channelCount;
+  while (frames) {
+    if (m_blockPos == m_5msFrames) {
+      _pumpBlock();
+      m_blockPos = 0;
+    }
+    const size_t count = std::min(frames, m_5msFrames - m_blockPos);
+    std::memcpy(out, m_blockBuf.data() + m_blockPos * channels, count * channels * sizeof(float));
+    m_blockPos += count;
+    out += count * channels;
+    frames -= count;
+  }
+
+  if (m_cbInterface)
+    m_cbInterface->_onPumpCycleComplete(*this);
+}
+
+} // namespace amuse
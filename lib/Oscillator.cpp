@@ -0,0 +1,48 @@
+#include "amuse/Oscillator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+
+#include "amuse/Common.hpp"
+
+namespace amuse {
+
+constexpr size_t SineTableSize = 256;
+
+/* One full cycle with a guard point so interpolation never wraps */
+static const std::array<float, SineTableSize + 1> SineTable = [] {
+  std::array<float, SineTableSize + 1> table{};
+  for (size_t i = 0; i <= SineTableSize; ++i)
+    table[i] = std::sin(float(i) / float(SineTableSize) * 2.f * M_PIF);
+  return table;
+}();
+
+void Oscillator::setPeriod(float period) { m_period = std::fabs(period) < FLT_EPSILON ? 0.f : period; }
+
+void Oscillator::advance(double dt) {
+  if (m_period == 0.f)
+    return;
+  m_phase += dt / m_period;
+  m_phase -= std::floor(m_phase);
+}
+
+float Oscillator::sine() const {
+  const float pos = float(m_phase) * float(SineTableSize);
+  /* Phase just below 1 may round up to the guard point in single precision */
+  const size_t idx = std::min(size_t(pos), SineTableSize - 1);
+  const float frac = pos - float(idx);
+  return SineTable[idx] + (SineTable[idx + 1] - SineTable[idx]) * frac;
+}
+
+float Oscillator::triangle() const {
+  const float phase = float(m_phase);
+  if (phase < 0.25f)
+    return phase / 0.25f;
+  if (phase >= 0.75f)
+    return (phase - 0.75f) / 0.25f - 1.f;
+  return (phase - 0.25f) / 0.5f * -2.f + 1.f;
+}
+
+} // namespace amuse
@@ -0,0 +1,151 @@
+#include "amuse/RenderPool.hpp"
+
+#include <algorithm>
+
+#if _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace amuse {
+
+static constexpr uint64_t PackRange(uint32_t begin, uint32_t end) { return (uint64_t(begin) << 32) | end; }
+
+static void PinCurrentThread(int cpu) {
+  if (cpu < 0)
+    return;
+#if _WIN32
+  if (cpu < int(sizeof(DWORD_PTR) * 8))
+    SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu);
+#elif __linux__
+  if (cpu < CPU_SETSIZE) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+#endif
+}
+
+RenderPool::RenderPool(size_t threads, const std::vector<int>& cpuAffinity)
+: m_ranges(new Range[std::max(threads, size_t(1))]) {
+  threads = std::max(threads, size_t(1));
+  m_threads.reserve(threads - 1);
+  for (size_t i = 1; i < threads; ++i) {
+    const int cpu = cpuAffinity.empty() ? -1 : cpuAffinity[(i - 1) % cpuAffinity.size()];
+    m_threads.emplace_back(&RenderPool::_workerThread, this, i, cpu);
+  }
+}
+
+RenderPool::~RenderPool() {
+  {
+    std::unique_lock lk(m_lock);
+    m_quit = true;
+  }
+  m_startCv.notify_all();
+  for (std::thread& thread : m_threads)
+    thread.join();
+}
+
+bool RenderPool::_popFront(size_t slot, size_t& idx) {
+  std::atomic<uint64_t>& range = m_ranges[slot].m_range;
+  uint64_t cur = range.load(std::memory_order_acquire);
+  for (;;) {
+    const auto begin = uint32_t(cur >> 32);
+    const auto end = uint32_t(cur);
+    if (begin >= end)
+      return false;
+    if (range.compare_exchange_weak(cur, PackRange(begin + 1, end), std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+      idx = begin;
+      return true;
+    }
+  }
+}
+
+bool RenderPool::_stealBack(size_t slot, size_t& idx) {
+  std::atomic<uint64_t>& range = m_ranges[slot].m_range;
+  uint64_t cur = range.load(std::memory_order_acquire);
+  for (;;) {
+    const auto begin = uint32_t(cur >> 32);
+    const auto end = uint32_t(cur);
+    if (begin >= end)
+      return false;
+    if (range.compare_exchange_weak(cur, PackRange(begin, end - 1), std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+      idx = end - 1;
+      return true;
+    }
+  }
+}
+
+void RenderPool::_work(size_t slot) {
+  const size_t numSlots = getNumThreads();
+  size_t idx;
+  for (;;) {
+    if (_popFront(slot, idx)) {
+      m_func(m_ctx, idx);
+      continue;
+    }
+    bool stole = false;
+    for (size_t i = 1; i < numSlots && !stole; ++i) {
+      if (_stealBack((slot + i) % numSlots, idx)) {
+        m_func(m_ctx, idx);
+        stole = true;
+      }
+    }
+    if (!stole)
+      return;
+  }
+}
+
+void RenderPool::_workerThread(size_t slot, int cpu) {
+  PinCurrentThread(cpu);
+  uint64_t seenGeneration = 0;
+  std::unique_lock lk(m_lock);
+  for (;;) {
+    m_startCv.wait(lk, [&]() { return m_quit || m_generation != seenGeneration; });
+    if (m_quit)
+      return;
+    seenGeneration = m_generation;
+    ++m_busy;
+    lk.unlock();
+    _work(slot);
+    lk.lock();
+    if (--m_busy == 0)
+      m_doneCv.notify_all();
+  }
+}
+
+void RenderPool::_run(size_t count, TaskFunc func, void* ctx) {
+  if (m_threads.empty() || count <= 1) {
+    for (size_t i = 0; i < count; ++i)
+      func(ctx, i);
+    return;
+  }
+
+  {
+    std::unique_lock lk(m_lock);
+    m_func = func;
+    m_ctx = ctx;
+    const size_t numSlots = getNumThreads();
+    for (size_t i = 0; i < numSlots; ++i)
+      m_ranges[i].m_range.store(PackRange(uint32_t(count * i / numSlots), uint32_t(count * (i + 1) / numSlots)),
+                                std::memory_order_release);
+    ++m_generation;
+  }
+  m_startCv.notify_all();
+
+  _work(0);
+
+  /* Indices are all claimed; wait for those still executing on workers */
+  std::unique_lock lk(m_lock);
+  m_doneCv.wait(lk, [&]() { return m_busy == 0; });
+}
+
+} // namespace amuse
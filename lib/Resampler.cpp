@@ -0,0 +1,359 @@
+#include "amuse/Resampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RESAMPLER_X86 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define RESAMPLER_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace amuse {
+
+namespace {
+
+/** Modified Bessel function of the first kind, order 0 (for the Kaiser window) */
+double BesselI0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+  for (int k = 1; k < 32; ++k) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+/** Kernel rows for SincPhases + 1 fractional offsets; row p applies to offsets [p, p + 1) / SincPhases */
+struct SincTable {
+  static constexpr double Passband = 0.9; /**< Fraction of the lower Nyquist rate passed */
+  static constexpr double KaiserBeta = 8.0;
+  static constexpr double Pi = 3.14159265358979323846;
+
+  alignas(16) float m_rows[Resampler::SincPhases + 1][Resampler::SincTaps];
+
+  /** Kernel for steps up to `maxStep`; above 1 the cutoff falls with the output Nyquist rate */
+  explicit SincTable(double maxStep) {
+    const double cutoff = Passband / std::max(maxStep, 1.0);
+    constexpr auto half = double(Resampler::SincTaps / 2);
+    const double i0Beta = BesselI0(KaiserBeta);
+    for (size_t p = 0; p <= Resampler::SincPhases; ++p) {
+      const double frac = double(p) / Resampler::SincPhases;
+      double sum = 0.0;
+      double row[Resampler::SincTaps];
+      for (size_t t = 0; t < Resampler::SincTaps; ++t) {
+        /* Tap t holds input sample (base - half + 1 + t); distance from the output position */
+        const double x = double(t) - (half - 1.0) - frac;
+        const double r = x / half;
+        const double window = std::abs(r) < 1.0 ? BesselI0(KaiserBeta * std::sqrt(1.0 - r * r)) / i0Beta : 0.0;
+        const double arg = Pi * cutoff * x;
+        const double sinc = x == 0.0 ? 1.0 : std::sin(arg) / arg;
+        row[t] = window * sinc;
+        sum += row[t];
+      }
+      /* Unity DC gain at every phase */
+      for (size_t t = 0; t < Resampler::SincTaps; ++t)
+        m_rows[p][t] = float(row[t] / sum);
+    }
+  }
+};
+
+/** Steps each band-limited table is designed for; a step uses the first table covering it.
+ *  Beyond the last, the kernel is too short to band-limit further and some aliasing remains. */
+constexpr double SincTableSteps[] = {1.0, 1.25, 1.5, 2.0, 3.0, 4.0, 6.0, 8.0};
+
+const SincTable& GetSincTable(double step) {
+  static const SincTable Tables[] = {SincTable(SincTableSteps[0]), SincTable(SincTableSteps[1]),
+                                     SincTable(SincTableSteps[2]), SincTable(SincTableSteps[3]),
+                                     SincTable(SincTableSteps[4]), SincTable(SincTableSteps[5]),
+                                     SincTable(SincTableSteps[6]), SincTable(SincTableSteps[7])};
+  static_assert(std::size(Tables) == std::size(SincTableSteps));
+  size_t i = 0;
+  while (i + 1 < std::size(SincTableSteps) && step > SincTableSteps[i])
+    ++i;
+  return Tables[i];
+}
+
+/** Dot product of 16 input samples with the kernel interpolated between two adjacent phase rows */
+float SincDot(const float* in, const float* row0, const float* row1, float frac) {
+#if RESAMPLER_X86
+  const __m128 f = _mm_set1_ps(frac);
+  __m128 acc = _mm_setzero_ps();
+  for (size_t t = 0; t < Resampler::SincTaps; t += 4) {
+    const __m128 c0 = _mm_load_ps(row0 + t);
+    const __m128 c = _mm_add_ps(c0, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(row1 + t), c0), f));
+    acc = _mm_add_ps(acc, _mm_mul_ps(c, _mm_loadu_ps(in + t)));
+  }
+  acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+  acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+  return _mm_cvtss_f32(acc);
+#elif RESAMPLER_NEON
+  const float32x4_t f = vdupq_n_f32(frac);
+  float32x4_t acc = vdupq_n_f32(0.f);
+  for (size_t t = 0; t < Resampler::SincTaps; t += 4) {
+    const float32x4_t c0 = vld1q_f32(row0 + t);
+    const float32x4_t c = vmlaq_f32(c0, vsubq_f32(vld1q_f32(row1 + t), c0), f);
+    acc = vmlaq_f32(acc, c, vld1q_f32(in + t));
+  }
+  const float32x2_t sum = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+  return vget_lane_f32(vpadd_f32(sum, sum), 0);
+#else
+  float acc = 0.f;
+  for (size_t t = 0; t < Resampler::SincTaps; ++t)
+    acc += (row0[t] + (row1[t] - row0[t]) * frac) * in[t];
+  return acc;
+#endif
+}
+
+float LinearFrame(const float* p, float t) { return p[0] + (p[1] - p[0]) * t; }
+
+float CubicFrame(const float* p, float t) {
+  const float a = -0.5f * p[0] + 1.5f * p[1] - 1.5f * p[2] + 0.5f * p[3];
+  const float b = p[0] - 2.5f * p[1] + 2.f * p[2] - 0.5f * p[3];
+  const float c = -0.5f * p[0] + 0.5f * p[2];
+  return ((a * t + b) * t + c) * t + p[1];
+}
+
+/* Linear and cubic interpolation run four output frames at a time. Each frame's taps are loaded as a row
+ * and transposed so every vector holds one tap of four frames. Positions and arithmetic follow
+ * LinearFrame/CubicFrame operation for operation, so results match the one-frame path exactly. */
+#if RESAMPLER_X86
+using Quad = __m128;
+Quad Splat(float v) { return _mm_set1_ps(v); }
+Quad Add(Quad a, Quad b) { return _mm_add_ps(a, b); }
+Quad Sub(Quad a, Quad b) { return _mm_sub_ps(a, b); }
+Quad Mul(Quad a, Quad b) { return _mm_mul_ps(a, b); }
+void Store(float* p, Quad v) { _mm_storeu_ps(p, v); }
+
+/** Read positions of successive output frames, kept in double precision four frames at a time */
+class QuadPositions {
+  __m128d m_base, m_step;
+  __m128d m_n01 = _mm_set_pd(1.0, 0.0);
+  __m128d m_n23 = _mm_set_pd(3.0, 2.0);
+
+public:
+  QuadPositions(double inPos, double step) : m_base(_mm_set1_pd(inPos)), m_step(_mm_set1_pd(step)) {}
+
+  /** Integer positions of the next four frames to `idx`; returns their fractions */
+  Quad next(int32_t* idx) {
+    const __m128d p01 = _mm_add_pd(m_base, _mm_mul_pd(m_step, m_n01));
+    const __m128d p23 = _mm_add_pd(m_base, _mm_mul_pd(m_step, m_n23));
+    m_n01 = _mm_add_pd(m_n01, _mm_set1_pd(4.0));
+    m_n23 = _mm_add_pd(m_n23, _mm_set1_pd(4.0));
+    const __m128i w01 = _mm_cvttpd_epi32(p01);
+    const __m128i w23 = _mm_cvttpd_epi32(p23);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(idx), _mm_unpacklo_epi64(w01, w23));
+    return _mm_movelh_ps(_mm_cvtpd_ps(_mm_sub_pd(p01, _mm_cvtepi32_pd(w01))),
+                         _mm_cvtpd_ps(_mm_sub_pd(p23, _mm_cvtepi32_pd(w23))));
+  }
+};
+
+void LoadPairs(const float* buf, const int32_t* idx, Quad& p0, Quad& p1) {
+  const auto pair = [buf](int32_t i) { return reinterpret_cast<const __m64*>(buf + i); };
+  const __m128 ab = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), pair(idx[0])), pair(idx[1]));
+  const __m128 cd = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), pair(idx[2])), pair(idx[3]));
+  p0 = _mm_shuffle_ps(ab, cd, _MM_SHUFFLE(2, 0, 2, 0));
+  p1 = _mm_shuffle_ps(ab, cd, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+void LoadRows(const float* buf, const int32_t* idx, Quad& p0, Quad& p1, Quad& p2, Quad& p3) {
+  p0 = _mm_loadu_ps(buf + idx[0]);
+  p1 = _mm_loadu_ps(buf + idx[1]);
+  p2 = _mm_loadu_ps(buf + idx[2]);
+  p3 = _mm_loadu_ps(buf + idx[3]);
+  _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+}
+#else
+#if RESAMPLER_NEON
+using Quad = float32x4_t;
+Quad Load(const float* p) { return vld1q_f32(p); }
+Quad Splat(float v) { return vdupq_n_f32(v); }
+Quad Add(Quad a, Quad b) { return vaddq_f32(a, b); }
+Quad Sub(Quad a, Quad b) { return vsubq_f32(a, b); }
+Quad Mul(Quad a, Quad b) { return vmulq_f32(a, b); }
+void Store(float* p, Quad v) { vst1q_f32(p, v); }
+
+void LoadPairs(const float* buf, const int32_t* idx, Quad& p0, Quad& p1) {
+  const float32x4x2_t p = vuzpq_f32(vcombine_f32(vld1_f32(buf + idx[0]), vld1_f32(buf + idx[1])),
+                                    vcombine_f32(vld1_f32(buf + idx[2]), vld1_f32(buf + idx[3])));
+  p0 = p.val[0];
+  p1 = p.val[1];
+}
+
+void LoadRows(const float* buf, const int32_t* idx, Quad& p0, Quad& p1, Quad& p2, Quad& p3) {
+  const float32x4x2_t r01 = vtrnq_f32(vld1q_f32(buf + idx[0]), vld1q_f32(buf + idx[1]));
+  const float32x4x2_t r23 = vtrnq_f32(vld1q_f32(buf + idx[2]), vld1q_f32(buf + idx[3]));
+  p0 = vcombine_f32(vget_low_f32(r01.val[0]), vget_low_f32(r23.val[0]));
+  p1 = vcombine_f32(vget_low_f32(r01.val[1]), vget_low_f32(r23.val[1]));
+  p2 = vcombine_f32(vget_high_f32(r01.val[0]), vget_high_f32(r23.val[0]));
+  p3 = vcombine_f32(vget_high_f32(r01.val[1]), vget_high_f32(r23.val[1]));
+}
+#else
+struct Quad {
+  float v[4];
+};
+Quad Load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+Quad Splat(float v) { return {{v, v, v, v}}; }
+Quad Add(Quad a, Quad b) { return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+Quad Sub(Quad a, Quad b) { return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}}; }
+Quad Mul(Quad a, Quad b) { return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}}; }
+void Store(float* p, Quad v) { std::copy(v.v, v.v + 4, p); }
+
+void LoadPairs(const float* buf, const int32_t* idx, Quad& p0, Quad& p1) {
+  for (size_t k = 0; k < 4; ++k) {
+    p0.v[k] = buf[idx[k]];
+    p1.v[k] = buf[idx[k] + 1];
+  }
+}
+
+void LoadRows(const float* buf, const int32_t* idx, Quad& p0, Quad& p1, Quad& p2, Quad& p3) {
+  for (size_t k = 0; k < 4; ++k) {
+    p0.v[k] = buf[idx[k]];
+    p1.v[k] = buf[idx[k] + 1];
+    p2.v[k] = buf[idx[k] + 2];
+    p3.v[k] = buf[idx[k] + 3];
+  }
+}
+#endif
+
+/** Read positions of successive output frames, four at a time */
+class QuadPositions {
+  double m_inPos;
+  double m_step;
+  size_t m_i = 0;
+
+public:
+  QuadPositions(double inPos, double step) : m_inPos(inPos), m_step(step) {}
+
+  /** Integer positions of the next four frames to `idx`; returns their fractions */
+  Quad next(int32_t* idx) {
+    float frac[4];
+    for (size_t k = 0; k < 4; ++k, ++m_i) {
+      const double pos = m_inPos + m_step * double(m_i);
+      idx[k] = int32_t(pos);
+      frac[k] = float(pos - double(idx[k]));
+    }
+    return Load(frac);
+  }
+};
+#endif
+
+Quad LinearQuad(const float* buf, const int32_t* idx, Quad t) {
+  Quad p0, p1;
+  LoadPairs(buf, idx, p0, p1);
+  return Add(p0, Mul(Sub(p1, p0), t));
+}
+
+Quad CubicQuad(const float* buf, const int32_t* idx, Quad t) {
+  Quad p0, p1, p2, p3;
+  LoadRows(buf, idx, p0, p1, p2, p3);
+  const Quad half = Splat(0.5f);
+  const Quad negHalf = Splat(-0.5f);
+  const Quad oneHalf = Splat(1.5f);
+  const Quad a = Add(Sub(Add(Mul(negHalf, p0), Mul(oneHalf, p1)), Mul(oneHalf, p2)), Mul(half, p3));
+  const Quad b = Sub(Add(Sub(p0, Mul(Splat(2.5f), p1)), Mul(Splat(2.f), p2)), Mul(half, p3));
+  const Quad c = Add(Mul(negHalf, p0), Mul(half, p2));
+  return Add(Mul(Add(Mul(Add(Mul(a, t), b), t), c), t), p1);
+}
+
+/** Interpolate `frames` outputs four at a time with QuadInterp, finishing the remainder with FrameInterp.
+ *  Positions are truncated to 32 bits, ample for the input of one block. */
+template <Quad (*QuadInterp)(const float*, const int32_t*, Quad), float (*FrameInterp)(const float*, float)>
+void InterpolateBlock(const float* buf, double inPos, double step, float* out, size_t frames) {
+  QuadPositions positions(inPos, step);
+  size_t i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    int32_t idx[4];
+    const Quad frac = positions.next(idx);
+    Store(out + i, QuadInterp(buf, idx, frac));
+  }
+  for (; i < frames; ++i) {
+    const double pos = inPos + step * double(i);
+    const auto idx = size_t(pos);
+    out[i] = FrameInterp(buf + idx, float(pos - double(idx)));
+  }
+}
+
+} // anonymous namespace
+
+size_t Resampler::_HalfTaps(ResamplerQuality quality) {
+  switch (quality) {
+  case ResamplerQuality::Cubic:
+    return 2;
+  case ResamplerQuality::Sinc:
+    return SincTaps / 2;
+  default:
+    return 1;
+  }
+}
+
+Resampler::Resampler(ResamplerQuality quality) : m_quality(quality) { reset(); }
+
+void Resampler::setQuality(ResamplerQuality quality) {
+  const size_t oldHistory = _halfTaps() - 1;
+  const size_t newHistory = _HalfTaps(quality) - 1;
+  if (newHistory > oldHistory)
+    m_inBuf.insert(m_inBuf.begin(), newHistory - oldHistory, 0.f);
+  else
+    m_inBuf.erase(m_inBuf.begin(), m_inBuf.begin() + (oldHistory - newHistory));
+  m_quality = quality;
+  if (quality == ResamplerQuality::Sinc)
+    GetSincTable(1.0);
+}
+
+void Resampler::reset() {
+  m_inBuf.assign(_halfTaps() - 1, 0.f);
+  m_inPos = 0.0;
+  if (m_quality == ResamplerQuality::Sinc)
+    GetSincTable(1.0);
+}
+
+size_t Resampler::inputNeeded(size_t frames, double step) const {
+  if (!frames)
+    return 0;
+  const size_t half = _halfTaps();
+  const size_t need = half - 1 + size_t(m_inPos + step * double(frames - 1)) + half + 1;
+  return need > m_inBuf.size() ? need - m_inBuf.size() : 0;
+}
+
+void Resampler::pushInput(const int16_t* in, size_t count) {
+  for (size_t i = 0; i < count; ++i)
+    m_inBuf.push_back(in[i] / 32768.f);
+}
+
+void Resampler::pushInput(const float* in, size_t count) { m_inBuf.insert(m_inBuf.end(), in, in + count); }
+
+void Resampler::process(float* out, size_t frames, double step) {
+  const float* buf = m_inBuf.data();
+  switch (m_quality) {
+  case ResamplerQuality::Linear:
+    InterpolateBlock<LinearQuad, LinearFrame>(buf, m_inPos, step, out, frames);
+    break;
+  case ResamplerQuality::Cubic:
+    InterpolateBlock<CubicQuad, CubicFrame>(buf, m_inPos, step, out, frames);
+    break;
+  case ResamplerQuality::Sinc: {
+    const SincTable& table = GetSincTable(step);
+    for (size_t i = 0; i < frames; ++i) {
+      const double pos = m_inPos + step * double(i);
+      const auto idx = size_t(pos);
+      const double phase = (pos - double(idx)) * SincPhases;
+      const auto row = size_t(phase);
+      out[i] = SincDot(buf + idx, table.m_rows[row], table.m_rows[row + 1], float(phase - double(row)));
+    }
+    break;
+  }
+  }
+
+  /* Drop input no longer reachable by the kernel, keeping history */
+  m_inPos += step * double(frames);
+  const size_t consumed = std::min(size_t(m_inPos), m_inBuf.size() - (_halfTaps() - 1));
+  m_inBuf.erase(m_inBuf.begin(), m_inBuf.begin() + consumed);
+  m_inPos -= double(consumed);
+}
+
+} // namespace amuse
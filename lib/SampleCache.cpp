@@ -0,0 +1,119 @@
+#include "amuse/SampleCache.hpp"
+
+#include <cstring>
+
+#include "amuse/DSPCodec.hpp"
+#include "amuse/N64MusyXCodec.hpp"
+
+namespace amuse {
+
+static bool DecodeSample(DecodedSample& out, const SampleEntryData& entry, const unsigned char* data) {
+  const uint32_t numSamples = entry.getNumSamples();
+  switch (entry.getSampleFormat()) {
+  case SampleFormat::DSP:
+  case SampleFormat::DSP_DRUM: {
+    out.m_pcm = std::make_unique<int16_t[]>(numSamples);
+    int16_t prev1 = 0;
+    int16_t prev2 = 0;
+    DSPDecompressFrames(out.m_pcm.get(), data, entry.m_ADPCMParms.dsp.m_coefs, &prev1, &prev2, numSamples);
+    break;
+  }
+  case SampleFormat::N64: {
+    out.m_pcm = std::make_unique<int16_t[]>(numSamples);
+    const unsigned char* cur = data + sizeof(AudioGroupSampleDirectory::ADPCMParms::VADPCMParms);
+    for (uint32_t s = 0; s < numSamples; s += 64, cur += 40) {
+      if (entry.m_vadpcmPredictor)
+        N64MusyXDecompressFrame(out.m_pcm.get() + s, cur, *entry.m_vadpcmPredictor, numSamples - s);
+      else
+        N64MusyXDecompressFrame(out.m_pcm.get() + s, cur, entry.m_ADPCMParms.vadpcm.m_coefs, numSamples - s);
+    }
+    break;
+  }
+  default:
+    /* PCM formats already play through the copy path */
+    return false;
+  }
+  out.m_numSamples = numSamples;
+  return true;
+}
+
+void SampleCache::_evict(LRUList::iterator it) {
+  m_stats.m_residentBytes -= it->second->byteSize();
+  --m_stats.m_residentSamples;
+  ++m_stats.m_evictions;
+  m_lookup.erase(it->first);
+  m_lru.erase(it);
+}
+
+void SampleCache::_trim(size_t budget) {
+  while (!m_lru.empty() && m_stats.m_residentBytes > budget)
+    _evict(std::prev(m_lru.end()));
+}
+
+void SampleCache::setBudget(size_t bytes) {
+  m_budget = bytes;
+  _trim(bytes);
+}
+
+ObjToken<DecodedSample> SampleCache::lookup(const AudioGroup& group, SampleId sampleId,
+                                            const ObjToken<SampleEntryData>& entry, const unsigned char* data) {
+  if (!m_budget)
+    return {};
+
+  const Key key{&group, sampleId};
+  auto search = m_lookup.find(key);
+  if (search != m_lookup.end()) {
+    if (search->second->second->m_entry == entry) {
+      ++m_stats.m_hits;
+      m_lru.splice(m_lru.begin(), m_lru, search->second);
+      return search->second->second;
+    }
+    /* Sample data was reloaded since it was decoded */
+    _evict(search->second);
+  }
+
+  const size_t bytes = entry->getNumSamples() * sizeof(int16_t);
+  if (!bytes || bytes > m_maxEntryBytes || bytes > m_budget)
+    return {};
+
+  ObjToken<DecodedSample> decoded = MakeObj<DecodedSample>();
+  if (!DecodeSample(*decoded, *entry, data))
+    return {};
+  decoded->m_entry = entry;
+
+  ++m_stats.m_misses;
+  _trim(m_budget - bytes);
+  m_lru.emplace_front(key, decoded);
+  m_lookup[key] = m_lru.begin();
+  m_stats.m_residentBytes += bytes;
+  ++m_stats.m_residentSamples;
+  return decoded;
+}
+
+void SampleCache::purgeGroup(const AudioGroup& group) {
+  for (auto it = m_lru.begin(); it != m_lru.end();) {
+    if (it->first.m_group == &group) {
+      m_stats.m_residentBytes -= it->second->byteSize();
+      --m_stats.m_residentSamples;
+      m_lookup.erase(it->first);
+      it = m_lru.erase(it);
+      continue;
+    }
+    ++it;
+  }
+}
+
+void SampleCache::clear() {
+  m_lru.clear();
+  m_lookup.clear();
+  m_stats.m_residentBytes = 0;
+  m_stats.m_residentSamples = 0;
+}
+
+void SampleCache::resetStats() {
+  m_stats.m_hits = 0;
+  m_stats.m_misses = 0;
+  m_stats.m_evictions = 0;
+}
+
+} // namespace amuse
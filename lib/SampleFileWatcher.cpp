@@ -0,0 +1,144 @@
+#include "amuse/SampleFileWatcher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#if __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace amuse {
+
+static constexpr std::string_view LooseSampleExtensions[] = {".wav", ".dsp", ".vadpcm"};
+
+SampleFileWatcher::SampleFileWatcher(std::string_view dirPath) : m_dirPath(dirPath) {
+#if __linux__
+  m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_inotifyFd >= 0) {
+    /* Editors typically write in place (close-write) or save-and-rename (moved-to) */
+    if (inotify_add_watch(m_inotifyFd, m_dirPath.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_ATTRIB) >= 0) {
+      m_thread = std::thread(&SampleFileWatcher::_inotifyThread, this);
+      return;
+    }
+    close(m_inotifyFd);
+    m_inotifyFd = -1;
+  }
+#endif
+  m_thread = std::thread(&SampleFileWatcher::_pollThread, this);
+}
+
+SampleFileWatcher::~SampleFileWatcher() {
+  {
+    std::unique_lock lk(m_watchLock);
+    m_running.store(false);
+  }
+  m_pollCv.notify_all();
+  if (m_thread.joinable())
+    m_thread.join();
+#if __linux__
+  if (m_inotifyFd >= 0)
+    close(m_inotifyFd);
+#endif
+}
+
+void SampleFileWatcher::watchSample(std::string_view baseName, const ObjToken<SampleEntry>& entry) {
+  {
+    std::unique_lock lk(m_watchLock);
+    Watch& watch = m_watches[std::string(baseName)];
+    watch.m_entry = entry;
+    watch.m_haveModTime = false;
+  }
+  /* Have the polling fallback take the baseline promptly so an edit right after registering is not missed */
+  m_pollCv.notify_one();
+}
+
+void SampleFileWatcher::unwatchSample(std::string_view baseName) {
+  std::unique_lock lk(m_watchLock);
+  m_watches.erase(std::string(baseName));
+}
+
+void SampleFileWatcher::_markDirty(std::string_view fileName) {
+  for (std::string_view ext : LooseSampleExtensions) {
+    if (fileName.size() <= ext.size() ||
+        CompareCaseInsensitive(fileName.data() + fileName.size() - ext.size(), ext.data()))
+      continue;
+    std::unique_lock lk(m_watchLock);
+    auto search = m_watches.find(std::string(fileName.substr(0, fileName.size() - ext.size())));
+    if (search != m_watches.end())
+      search->second.m_entry->m_looseDirty.store(true, std::memory_order_release);
+    return;
+  }
+}
+
+time_t SampleFileWatcher::_pollModTime(const std::string& baseName) const {
+  std::string basePath = m_dirPath + '/' + baseName;
+  time_t ret = 0;
+  for (std::string_view ext : LooseSampleExtensions) {
+    Sstat theStat;
+    if (!Stat((basePath + ext.data()).c_str(), &theStat) && S_ISREG(theStat.st_mode))
+      ret = std::max(ret, time_t(theStat.st_mtime));
+  }
+  return ret;
+}
+
+#if __linux__
+void SampleFileWatcher::_inotifyThread() {
+  alignas(struct inotify_event) char buf[4096];
+  pollfd pfd = {m_inotifyFd, POLLIN, 0};
+  while (m_running.load()) {
+    /* Bounded wait so destruction never blocks on a quiet directory */
+    if (poll(&pfd, 1, 250) <= 0)
+      continue;
+    ssize_t len;
+    while ((len = read(m_inotifyFd, buf, sizeof(buf))) > 0) {
+      for (char* ptr = buf; ptr < buf + len;) {
+        const auto* ev = reinterpret_cast<const struct inotify_event*>(ptr);
+        if (ev->len)
+          _markDirty(ev->name);
+        ptr += sizeof(struct inotify_event) + ev->len;
+      }
+    }
+  }
+}
+#endif
+
+void SampleFileWatcher::_pollThread() {
+  std::vector<std::pair<std::string, time_t>> snapshot;
+  std::unique_lock lk(m_watchLock);
+  while (m_running.load()) {
+    m_pollCv.wait_for(lk, std::chrono::milliseconds(PollIntervalMs));
+    if (!m_running.load())
+      break;
+
+    /* Stat outside the lock so registration from other threads stays cheap */
+    snapshot.clear();
+    snapshot.reserve(m_watches.size());
+    for (const auto& p : m_watches)
+      snapshot.emplace_back(p.first, p.second.m_lastModTime);
+    lk.unlock();
+    for (auto& p : snapshot)
+      p.second = _pollModTime(p.first);
+    lk.lock();
+
+    for (const auto& p : snapshot) {
+      auto search = m_watches.find(p.first);
+      if (search == m_watches.end())
+        continue;
+      Watch& watch = search->second;
+      if (!watch.m_haveModTime) {
+        watch.m_lastModTime = p.second;
+        watch.m_haveModTime = true;
+        continue;
+      }
+      if (p.second == watch.m_lastModTime)
+        continue;
+      watch.m_lastModTime = p.second;
+      watch.m_entry->m_looseDirty.store(true, std::memory_order_release);
+    }
+  }
+}
+
+} // namespace amuse
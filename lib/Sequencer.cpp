@@ -203,27 +203,38 @@ ObjToken<Voice> Sequencer::ChannelState::keyOn(uint8_t note, uint8_t velocity) {
     m_chanVoxs.erase(keySearch);
   }
 
-  std::list<ObjToken<Voice>>::iterator ret = m_parent->m_engine._allocateVoice(
-      m_parent->m_audioGroup, m_parent->m_groupId, NativeSampleRate, true, false, m_parent->m_studio);
+  /* Resolve page object up front so its priority and voice limit govern allocation */
+  ObjectId oid;
+  uint8_t pageKey = note;
+  uint8_t priority, maxVoices;
+  const void* limitTag;
+  if (m_parent->m_songGroup) {
+    oid = m_page->objId;
+    priority = m_page->priority;
+    maxVoices = m_page->maxVoices;
+    limitTag = m_page;
+  } else if (m_parent->m_sfxMappings.size()) {
+    size_t lookupIdx = note % m_parent->m_sfxMappings.size();
+    const SFXGroupIndex::SFXEntry* sfxEntry = m_parent->m_sfxMappings[lookupIdx];
+    oid = sfxEntry->objId;
+    pageKey = sfxEntry->defKey;
+    priority = sfxEntry->priority;
+    maxVoices = sfxEntry->maxVoices;
+    limitTag = sfxEntry;
+  } else
+    return {};
+
+  std::list<ObjToken<Voice>>::iterator ret =
+      m_parent->m_engine._allocateVoice(m_parent->m_audioGroup, m_parent->m_groupId, NativeSampleRate, true, false,
+                                        m_parent->m_studio, priority, maxVoices, limitTag);
+  if (ret == m_parent->m_engine.m_activeVoices.end())
+    return {};
   if (*ret) {
     (*ret)->m_sequencer = m_parent;
     m_chanVoxs[note] = *ret;
     (*ret)->installCtrlValues(m_ctrlVals.data());
 
-    ObjectId oid;
-    bool res;
-    if (m_parent->m_songGroup) {
-      oid = m_page->objId;
-      res = (*ret)->loadPageObject(oid, m_ticksPerSec, note, velocity, m_ctrlVals[1]);
-    } else if (m_parent->m_sfxMappings.size()) {
-      size_t lookupIdx = note % m_parent->m_sfxMappings.size();
-      const SFXGroupIndex::SFXEntry* sfxEntry = m_parent->m_sfxMappings[lookupIdx];
-      oid = sfxEntry->objId;
-      note = sfxEntry->defKey;
-      res = (*ret)->loadPageObject(oid, m_ticksPerSec, note, velocity, m_ctrlVals[1]);
-    } else
-      return {};
-
+    bool res = (*ret)->loadPageObject(oid, m_ticksPerSec, pageKey, velocity, m_ctrlVals[1]);
     if (!res) {
       m_parent->m_engine._destroyVoice(ret);
       return {};
@@ -3,6 +3,7 @@
 #include <cmath>
 
 #include "amuse/Common.hpp"
+#include "amuse/Engine.hpp"
 #include "amuse/Sequencer.hpp"
 
 namespace amuse {
@@ -399,6 +400,7 @@ void SongState::Track::resetTempo() {
 }
 
 bool SongState::Track::advance(Sequencer& seq, double dt) {
+  const double startDt = m_remDt; /* Time already elapsed past m_curTick when this interval began */
   m_remDt += dt;
 
   /* Compute ticks to compute based on current tempo */
@@ -431,6 +433,13 @@ bool SongState::Track::advance(Sequencer& seq, double dt) {
   m_remDt -= ticks / ticksPerSecond;
   uint32_t endTick = m_curTick + ticks;
 
+  /* Start voices at the event's position within the interval rather than its beginning */
+  int32_t waitedTicks = 0;
+  auto placeEvent = [&]() {
+    const double eventTime = (waitedTicks + m_eventWaitCountdown) / ticksPerSecond - startDt;
+    seq.getEngine().setEventOffset(std::clamp(eventTime, 0.0, dt));
+  };
+
   /* Advance region if needed */
   while (m_nextRegion->indexValid(m_parent->m_bigEndian)) {
     uint32_t nextRegTick = (m_parent->m_bigEndian ? SBig(m_nextRegion->m_startTick) : m_nextRegion->m_startTick);
@@ -506,6 +515,7 @@ bool SongState::Track::advance(Sequencer& seq, double dt) {
         /* Advance wait timer if active, returning if waiting */
         if (m_eventWaitCountdown != 0) {
           m_eventWaitCountdown -= static_cast<int32_t>(ticks);
+          waitedTicks += static_cast<int32_t>(ticks);
           ticks = 0;
           if (m_eventWaitCountdown > 0) {
             break;
@@ -535,6 +545,7 @@ bool SongState::Track::advance(Sequencer& seq, double dt) {
           uint8_t vel = m_data[1] & 0x7f;
           uint16_t length = (m_parent->m_bigEndian ? SBig(*reinterpret_cast<const uint16_t*>(m_data + 2))
                                                    : *reinterpret_cast<const uint16_t*>(m_data + 2));
+          placeEvent();
           seq.keyOn(m_midiChan, note, vel);
           if (length == 0) {
             seq.keyOff(m_midiChan, note, 0);
@@ -552,6 +563,7 @@ bool SongState::Track::advance(Sequencer& seq, double dt) {
         /* Advance wait timer if active, returning if waiting */
         if (m_eventWaitCountdown != 0) {
           m_eventWaitCountdown -= static_cast<int32_t>(ticks);
+          waitedTicks += static_cast<int32_t>(ticks);
           ticks = 0;
           if (m_eventWaitCountdown > 0) {
             break;
@@ -570,6 +582,7 @@ bool SongState::Track::advance(Sequencer& seq, double dt) {
                                                    : *reinterpret_cast<const uint16_t*>(m_data));
           uint8_t note = m_data[2] & 0x7f;
           uint8_t vel = m_data[3] & 0x7f;
+          placeEvent();
           seq.keyOn(m_midiChan, note, vel);
           if (length == 0) {
             seq.keyOff(m_midiChan, note, 0);
@@ -22,9 +22,11 @@ namespace amuse {
 
 void SoundMacroState::Evaluator::addComponent(uint8_t midiCtrl, float scale, Combine combine, VarType varType) {
   m_comps.push_back({midiCtrl, scale, combine, varType});
+  if (varType == VarType::Ctrl && (midiCtrl == 130 || midiCtrl == 131))
+    m_timeVarying = true;
 }
 
-float SoundMacroState::Evaluator::evaluate(double time, const Voice& vox, const SoundMacroState& st) const {
+float SoundMacroState::Evaluator::evaluate(const Voice& vox, const SoundMacroState& st) const {
   float value = 0.f;
 
   /* Iterate each component */
@@ -45,13 +47,13 @@ float SoundMacroState::Evaluator::evaluate(double time, const Voice& vox, const
         break;
       case 130:
         /* LFO1 */
-        if (vox.m_lfoPeriods[0])
-          thisValue = (std::sin(time / vox.m_lfoPeriods[0] * 2.f * M_PIF) * 0.5f + 0.5f) * 127.f;
+        if (vox.m_lfos[0].isActive())
+          thisValue = (vox.m_lfos[0].sine() * 0.5f + 0.5f) * 127.f;
         break;
       case 131:
         /* LFO2 */
-        if (vox.m_lfoPeriods[1])
-          thisValue = (std::sin(time / vox.m_lfoPeriods[1] * 2.f * M_PIF) * 0.5f + 0.5f) * 127.f;
+        if (vox.m_lfos[1].isActive())
+          thisValue = (vox.m_lfos[1].sine() * 0.5f + 0.5f) * 127.f;
         break;
       case 132:
         /* Surround panning */
@@ -376,7 +378,7 @@ const SoundMacro::CmdIntrospection SoundMacro::CmdPlayMacro::Introspective = {
      {FIELD_HEAD(SoundMacro::CmdPlayMacro, priority), "Priority"sv, 0, 127, 50},
      {FIELD_HEAD(SoundMacro::CmdPlayMacro, maxVoices), "Max Voices"sv, 0, 255, 255}}}};
 bool SoundMacro::CmdPlayMacro::Do(SoundMacroState& st, Voice& vox) const {
-  ObjToken<Voice> sibVox = vox.startChildMacro(addNote, macro.id, macroStep.step);
+  ObjToken<Voice> sibVox = vox.startChildMacro(addNote, macro.id, macroStep.step, priority, maxVoices, this);
   if (sibVox)
     st.m_lastPlayMacroVid = sibVox->vid();
 
@@ -1034,14 +1036,20 @@ const SoundMacro::CmdIntrospection SoundMacro::CmdAddAgeCount::Introspective = {
     "Add Age Count"sv,
     "Adds a value to the current voice's age counter."sv,
     {{{FIELD_HEAD(SoundMacro::CmdAddAgeCount, add), "Add"sv, -32768, 32767, -30000}}}};
-bool SoundMacro::CmdAddAgeCount::Do(SoundMacroState& st, Voice& vox) const { return false; }
+bool SoundMacro::CmdAddAgeCount::Do(SoundMacroState& st, Voice& vox) const {
+  vox.setAgeCount(uint16_t(std::clamp(int32_t(vox.getAgeCount()) + add, 0, 65535)));
+  return false;
+}
 
 const SoundMacro::CmdIntrospection SoundMacro::CmdSetAgeCount::Introspective = {
     CmdType::Special,
     "Set Age Count"sv,
     "Set a value into the current voice's age counter."sv,
     {{{FIELD_HEAD(SoundMacro::CmdSetAgeCount, counter), "Counter"sv, 0, 65535, 0}}}};
-bool SoundMacro::CmdSetAgeCount::Do(SoundMacroState& st, Voice& vox) const { return false; }
+bool SoundMacro::CmdSetAgeCount::Do(SoundMacroState& st, Voice& vox) const {
+  vox.setAgeCount(counter);
+  return false;
+}
 
 const SoundMacro::CmdIntrospection SoundMacro::CmdSendFlag::Introspective = {
     CmdType::Special,
@@ -1070,21 +1078,30 @@ const SoundMacro::CmdIntrospection SoundMacro::CmdSetPriority::Introspective = {
     "Set Priority"sv,
     "Sets the priority of the current voice."sv,
     {{{FIELD_HEAD(SoundMacro::CmdSetPriority, prio), "Priority"sv, 0, 254, 50}}}};
-bool SoundMacro::CmdSetPriority::Do(SoundMacroState& st, Voice& vox) const { return false; }
+bool SoundMacro::CmdSetPriority::Do(SoundMacroState& st, Voice& vox) const {
+  vox.setPriority(prio);
+  return false;
+}
 
 const SoundMacro::CmdIntrospection SoundMacro::CmdAddPriority::Introspective = {
     CmdType::Special,
     "Add Priority"sv,
     "Adds to the priority of the current voice."sv,
     {{{FIELD_HEAD(SoundMacro::CmdAddPriority, prio), "Priority"sv, -255, 255, 1}}}};
-bool SoundMacro::CmdAddPriority::Do(SoundMacroState& st, Voice& vox) const { return false; }
+bool SoundMacro::CmdAddPriority::Do(SoundMacroState& st, Voice& vox) const {
+  vox.setPriority(uint8_t(std::clamp(int32_t(vox.getPriority()) + prio, 0, 255)));
+  return false;
+}
 
 const SoundMacro::CmdIntrospection SoundMacro::CmdAgeCntSpeed::Introspective = {
     CmdType::Special,
     "Age Count Speed"sv,
     "Sets the speed the current voice's age counter is decremented."sv,
     {{{FIELD_HEAD(SoundMacro::CmdAgeCntSpeed, time), "Millisec"sv, 0, 16777215, 1080000}}}};
-bool SoundMacro::CmdAgeCntSpeed::Do(SoundMacroState& st, Voice& vox) const { return false; }
+bool SoundMacro::CmdAgeCntSpeed::Do(SoundMacroState& st, Voice& vox) const {
+  vox.setAgeCountSpeed(time);
+  return false;
+}
 
 const SoundMacro::CmdIntrospection SoundMacro::CmdAgeCntVel::Introspective = {
     CmdType::Special,
@@ -1092,7 +1109,12 @@ const SoundMacro::CmdIntrospection SoundMacro::CmdAgeCntVel::Introspective = {
     "Sets the current voice's age counter by scaling the velocity."sv,
     {{{FIELD_HEAD(SoundMacro::CmdAgeCntVel, ageBase), "Base"sv, 0, 65535, 60000},
      {FIELD_HEAD(SoundMacro::CmdAgeCntVel, ageScale), "Scale"sv, 0, 65535, 127}}}};
-bool SoundMacro::CmdAgeCntVel::Do(SoundMacroState& st, Voice& vox) const { return false; }
+bool SoundMacro::CmdAgeCntVel::Do(SoundMacroState& st, Voice& vox) const {
+  /* Softer notes start out older and are stolen sooner */
+  int32_t count = int32_t(ageBase) - int32_t(ageScale) * (127 - st.m_curVel);
+  vox.setAgeCount(uint16_t(std::clamp(count, 0, 65535)));
+  return false;
+}
 
 const SoundMacro::CmdIntrospection SoundMacro::CmdVolSelect::Introspective = {
     CmdType::Setup,
@@ -1,5 +1,10 @@
 #include "amuse/Submix.hpp"
 
+#include <algorithm>
+
+#include "amuse/Engine.hpp"
+#include "amuse/EngineStats.hpp"
+
 namespace amuse {
 
 Submix::Submix(Engine& engine) : m_root(engine) {}
@@ -10,6 +15,14 @@ EffectChorus& Submix::makeChorus(uint32_t baseDelay, uint32_t variation, uint32_
 
 EffectChorus& Submix::makeChorus(const EffectChorusInfo& info) { return makeEffect<EffectChorus>(info); }
 
+EffectConvolution& Submix::makeConvolution(std::string_view irPath, float mix) {
+  return makeEffect<EffectConvolution>(irPath, mix);
+}
+
+EffectConvolution& Submix::makeConvolution(const EffectConvolutionInfo& info) {
+  return makeEffect<EffectConvolution>(info);
+}
+
 EffectDelay& Submix::makeDelay(uint32_t initDelay, uint32_t initFeedback, uint32_t initOutput) {
   return makeEffect<EffectDelay>(initDelay, initFeedback, initOutput);
 }
@@ -29,19 +42,52 @@ EffectReverbHi& Submix::makeReverbHi(float coloration, float mix, float time, fl
 
 EffectReverbHi& Submix::makeReverbHi(const EffectReverbHiInfo& info) { return makeEffect<EffectReverbHi>(info); }
 
-void Submix::applyEffect(int16_t* audio, size_t frameCount, const ChannelMap& chanMap) const {
+double Submix::getTailTime() const {
+  double tail = 0.0;
   for (const std::unique_ptr<EffectBaseTypeless>& effect : m_effectStack)
-    ((EffectBase<int16_t>&)*effect).applyEffect(audio, frameCount, chanMap);
+    tail += effect->getTailTime();
+  return tail;
+}
+
+template <typename T>
+void Submix::_applyEffect(T* audio, size_t frameCount, const ChannelMap& chanMap) const {
+  double time = 0.0;
+  {
+    ProfileScope prof(time);
+    const size_t sampleCount = frameCount * chanMap.m_channelCount;
+    if (EffectBase<T>::Energy(audio, sampleCount) > SilenceEnergy) {
+      m_silentTime = 0.0;
+      m_sleeping.store(false, std::memory_order_relaxed);
+    } else if (!m_sleeping.load(std::memory_order_relaxed)) {
+      m_silentTime += frameCount / m_backendSubmix->getSampleRate();
+    }
+
+    if (m_sleeping.load(std::memory_order_relaxed)) {
+      std::fill(audio, audio + sampleCount, T(0));
+    } else {
+      for (const std::unique_ptr<EffectBaseTypeless>& effect : m_effectStack)
+        static_cast<EffectBase<T>&>(*effect).applyEffect(audio, frameCount, chanMap);
+
+      /* Sleep once silent input has outlasted the stack's tail and the output agrees it has decayed */
+      if (m_silentTime > 0.0 && m_silentTime >= getTailTime() &&
+          EffectBase<T>::Energy(audio, sampleCount) <= SilenceEnergy)
+        m_sleeping.store(true, std::memory_order_relaxed);
+    }
+  }
+  m_effectTime.store(float(time), std::memory_order_relaxed);
+  m_root.m_cycleStats.m_effects.add(time);
+}
+
+void Submix::applyEffect(int16_t* audio, size_t frameCount, const ChannelMap& chanMap) const {
+  _applyEffect(audio, frameCount, chanMap);
 }
 
 void Submix::applyEffect(int32_t* audio, size_t frameCount, const ChannelMap& chanMap) const {
-  for (const std::unique_ptr<EffectBaseTypeless>& effect : m_effectStack)
-    ((EffectBase<int32_t>&)*effect).applyEffect(audio, frameCount, chanMap);
+  _applyEffect(audio, frameCount, chanMap);
 }
 
 void Submix::applyEffect(float* audio, size_t frameCount, const ChannelMap& chanMap) const {
-  for (const std::unique_ptr<EffectBaseTypeless>& effect : m_effectStack)
-    ((EffectBase<float>&)*effect).applyEffect(audio, frameCount, chanMap);
+  _applyEffect(audio, frameCount, chanMap);
 }
 
 void Submix::resetOutputSampleRate(double sampleRate) {
@@ -7,12 +7,20 @@
 #include "amuse/Common.hpp"
 #include "amuse/DSPCodec.hpp"
 #include "amuse/Engine.hpp"
+#include "amuse/EngineStats.hpp"
 #include "amuse/IBackendVoice.hpp"
 #include "amuse/IBackendVoiceAllocator.hpp"
 #include "amuse/N64MusyXCodec.hpp"
 #include "amuse/Submix.hpp"
+#include "amuse/VoicePool.hpp"
 #include "amuse/VolumeTable.hpp"
 
+#if __SSE2__
+#include <emmintrin.h>
+#elif __ARM_NEON
+#include <arm_neon.h>
+#endif
+
 namespace amuse {
 
 float Voice::VolumeCache::getVolume(float vol, bool dls) {
@@ -29,28 +37,52 @@ float Voice::VolumeCache::getVolume(float vol, bool dls) {
 
 void Voice::_destroy() {
   Entity::_destroy();
+  ++m_engine.m_cycleStats.m_voicesKilled;
+  if (!_isStolen())
+    --m_engine.m_numPolyVoices;
 
   for (auto& vox : m_childVoices)
     vox->_destroy();
+  /* Every voice is destroyed here before release, so this is where child list nodes go back to the pool */
+  m_engine.m_voicePool->unlinkAll(m_childVoices);
 
   m_studio.reset();
+  /* Park the backend voice in this slot for the next occupant to rebind */
+  if (m_backendVoice && m_engine.getBackend().releaseVoice(*m_backendVoice))
+    VoicePool::HeaderOf(this)->m_backendSpare = std::move(m_backendVoice);
   m_backendVoice.reset();
   m_curSample.reset();
+  m_curDecoded.reset();
   m_sequencer.reset();
 }
 
+void* Voice::operator new(size_t sz) { return VoicePool::AllocateHeap(sz); }
+void* Voice::operator new(size_t sz, VoicePool& pool) noexcept { return pool.allocate(sz); }
+void Voice::operator delete(void* ptr) { VoicePool::Deallocate(ptr); }
+void Voice::operator delete(void* ptr, VoicePool&) { VoicePool::Deallocate(ptr); }
+
 Voice::~Voice() {
   // fprintf(stderr, "DEALLOC %d\n", m_vid);
+  /* Hand macro call-stack storage back to the slot for the next occupant */
+  SoundMacroState::PCStack& spare = VoicePool::HeaderOf(this)->m_pcSpare;
+  spare.swap(m_state.m_pc);
+  spare.clear();
 }
 
 Voice::Voice(Engine& engine, const AudioGroup& group, GroupId groupId, int vid, bool emitter, ObjToken<Studio> studio)
 : Entity(engine, group, groupId), m_vid(vid), m_emitter(emitter), m_studio(studio) {
   // fprintf(stderr, "ALLOC %d\n", m_vid);
+  m_state.m_pc.swap(VoicePool::HeaderOf(this)->m_pcSpare);
+  ++m_engine.m_numPolyVoices;
+  ++m_engine.m_cycleStats.m_voicesStarted;
 }
 
 Voice::Voice(Engine& engine, const AudioGroup& group, GroupId groupId, ObjectId oid, int vid, bool emitter,
              ObjToken<Studio> studio)
 : Entity(engine, group, groupId, oid), m_vid(vid), m_emitter(emitter), m_studio(studio) {
+  m_state.m_pc.swap(VoicePool::HeaderOf(this)->m_pcSpare);
+  ++m_engine.m_numPolyVoices;
+  ++m_engine.m_cycleStats.m_voicesStarted;
   // fprintf(stderr, "ALLOC %d\n", m_vid);
 }
 
@@ -163,12 +195,20 @@ std::unique_ptr<int8_t[]>& Voice::_ensureCtrlVals() {
   return m_ctrlValsSelf;
 }
 
-std::list<ObjToken<Voice>>::iterator Voice::_allocateVoice(double sampleRate, bool dynamicPitch) {
-  amuse::ObjToken<Voice> tok =
-      MakeObj<Voice>(m_engine, m_audioGroup, m_groupId, m_engine.m_nextVid++, m_emitter, m_studio);
-  auto it = m_childVoices.emplace(m_childVoices.end(), tok);
-  m_childVoices.back()->m_backendVoice =
-      m_engine.getBackend().allocateVoice(*m_childVoices.back(), sampleRate, dynamicPitch);
+std::list<ObjToken<Voice>>::iterator Voice::_allocateVoice(double sampleRate, bool dynamicPitch, uint8_t priority,
+                                                           uint8_t maxVoices, const void* limitTag) {
+  if (!m_engine._reserveVoice(priority, maxVoices, limitTag))
+    return m_childVoices.end();
+
+  VoicePool& pool = *m_engine.m_voicePool;
+  Voice* vox = new (pool) Voice(m_engine, m_audioGroup, m_groupId, m_engine.m_nextVid, m_emitter, m_studio);
+  if (!vox)
+    return m_childVoices.end();
+  ++m_engine.m_nextVid;
+  auto it = pool.linkVoice(m_childVoices, ObjToken<Voice>(vox));
+  (*it)->m_priority = priority;
+  (*it)->m_limitTag = limitTag;
+  (*it)->m_backendVoice = m_engine._bindBackendVoice(**it, sampleRate, dynamicPitch);
   return it;
 }
 
@@ -177,7 +217,15 @@ std::list<ObjToken<Voice>>::iterator Voice::_destroyVoice(std::list<ObjToken<Voi
     return m_childVoices.begin();
 
   (*it)->_destroy();
-  return m_childVoices.erase(it);
+  return m_engine.m_voicePool->unlinkVoice(m_childVoices, it);
+}
+
+void Voice::_steal() {
+  if (_isStolen())
+    return;
+  /* Stolen voices fade out and no longer count toward polyphony limits */
+  m_stealFade = 1.f;
+  --m_engine.m_numPolyVoices;
 }
 
 template <typename T>
@@ -185,36 +233,20 @@ static T ApplyVolume(float vol, T samp) {
   return samp * vol;
 }
 
-void Voice::_procSamplePre(int16_t& samp) {
-  double dt = 0.0;
+/* PerSample mode resolves amplitude at this sub-block rate and ramps between control points */
+constexpr uint32_t PerSampleControlInterval = 8;
 
-  /* Block linearized will use a larger `dt` for amplitude sampling;
-   * significantly reducing the processing expense */
-  switch (m_engine.m_ampMode) {
-  case AmplitudeMode::PerSample:
-    m_voiceSamples += 1;
-    dt = 1.0 / m_sampleRate;
-    break;
-  case AmplitudeMode::BlockLinearized: {
-    uint32_t rem = m_voiceSamples % 160;
-    m_voiceSamples += 1;
-    dt = m_sampleRate * 160;
-    if (rem != 0) {
-      /* Lerp within 160-sample block */
-      const float t = rem / 160.f;
-      const float l = std::clamp(m_lastLevel * (1.f - t) + m_nextLevel * t, 0.f, 1.f);
-
-      /* Apply total volume to sample using decibel scale */
-      samp = ApplyVolume(m_lerpedCache.getVolume(l * m_engine.m_masterVolume, m_dlsVol), samp);
-      return;
-    }
+/* BlockLinearized mode resolves amplitude every 160 samples */
+constexpr uint32_t LinearizedControlInterval = 160;
 
-    dt = 160.0 / m_sampleRate;
-    break;
-  }
-  }
+/* Stolen voices ramp to silence over this many seconds before being reaped */
+constexpr double VoiceStealFadeTime = 0.01;
 
+void Voice::_advanceAmplitude(uint32_t samples) {
+  const double dt = samples / m_sampleRate;
   m_voiceTime += dt;
+  m_lfos[0].advance(dt);
+  m_lfos[1].advance(dt);
 
   /* Process active envelope */
   if (m_envelopeTime >= 0.0) {
@@ -241,7 +273,7 @@ void Voice::_procSamplePre(int16_t& samp) {
     if (m_targetUserVol != m_curUserVol) {
       float samplesPer5Ms = m_sampleRate * 5.f / 1000.f;
       if (samplesPer5Ms > 1.f) {
-        float adjRate = 1.f / samplesPer5Ms;
+        float adjRate = samples / samplesPer5Ms;
         if (m_targetUserVol < m_curUserVol) {
           m_curUserVol -= adjRate;
           if (m_targetUserVol > m_curUserVol)
@@ -264,10 +296,10 @@ void Voice::_procSamplePre(int16_t& samp) {
 
   /* Apply tremolo */
   if (m_state.m_tremoloSel && (m_tremoloScale || m_tremoloModScale)) {
-    float t = m_state.m_tremoloSel.evaluate(m_voiceTime, *this, m_state) / 127.f;
+    float t = m_state.m_tremoloSel.evaluate(*this, m_state) / 127.f;
     if (m_tremoloScale && m_tremoloModScale) {
       float fac = (1.0f - t) + (m_tremoloScale * t);
-      float modT = m_state.m_modWheelSel ? (m_state.m_modWheelSel.evaluate(m_voiceTime, *this, m_state) / 127.f)
+      float modT = m_state.m_modWheelSel ? (m_state.m_modWheelSel.evaluate(*this, m_state) / 127.f)
                                          : (getCtrlValue(1) / 127.f);
       float modFac = (1.0f - modT) + (m_tremoloModScale * modT);
       m_nextLevel *= fac * modFac;
@@ -275,7 +307,7 @@ void Voice::_procSamplePre(int16_t& samp) {
       float fac = (1.0f - t) + (m_tremoloScale * t);
       m_nextLevel *= fac;
     } else if (m_tremoloModScale) {
-      float modT = m_state.m_modWheelSel ? (m_state.m_modWheelSel.evaluate(m_voiceTime, *this, m_state) / 127.f)
+      float modT = m_state.m_modWheelSel ? (m_state.m_modWheelSel.evaluate(*this, m_state) / 127.f)
                                          : (getCtrlValue(1) / 127.f);
       float modFac = (1.0f - modT) + (m_tremoloModScale * modT);
       m_nextLevel *= modFac;
@@ -284,30 +316,165 @@ void Voice::_procSamplePre(int16_t& samp) {
 
   m_nextLevel = std::clamp(m_nextLevel, 0.f, 1.f);
 
-  /* Apply total volume to sample using decibel scale */
-  samp = ApplyVolume(m_nextLevelCache.getVolume(m_nextLevel * m_engine.m_masterVolume, m_dlsVol), samp);
+  /* Fade out after being stolen */
+  if (_isStolen()) {
+    m_stealFade = std::max(0.f, m_stealFade - float(dt / VoiceStealFadeTime));
+    m_nextLevel *= m_stealFade;
+  }
 }
 
-template <typename T>
-T Voice::_procSampleMaster(double time, T samp) {
-  const float evalVol = m_state.m_volumeSel ? (m_state.m_volumeSel.evaluate(time, *this, m_state) / 127.f) : 1.f;
-  return ApplyVolume(m_masterCache.getVolume(std::clamp(evalVol, 0.f, 1.f), m_dlsVol), samp);
+/* Fills `levels` with the lerp between `last` and `next` at `(pos + i) / interval`, clamped to [0,1] and
+ * scaled by `master`. Operation order matches the scalar expression exactly so SIMD lanes are bit-identical. */
+static void RampLevels(float* levels, uint32_t count, uint32_t pos, uint32_t interval, float last, float next,
+                       float master) {
+  uint32_t i = 0;
+#if __SSE2__
+  const __m128 vLast = _mm_set1_ps(last);
+  const __m128 vNext = _mm_set1_ps(next);
+  const __m128 vMaster = _mm_set1_ps(master);
+  const __m128 vInterval = _mm_set1_ps(float(interval));
+  const __m128 vZero = _mm_setzero_ps();
+  const __m128 vOne = _mm_set1_ps(1.f);
+  __m128i vPos = _mm_add_epi32(_mm_set1_epi32(int(pos)), _mm_setr_epi32(0, 1, 2, 3));
+  for (; i + 4 <= count; i += 4) {
+    const __m128 t = _mm_div_ps(_mm_cvtepi32_ps(vPos), vInterval);
+    __m128 l = _mm_add_ps(_mm_mul_ps(vLast, _mm_sub_ps(vOne, t)), _mm_mul_ps(vNext, t));
+    l = _mm_min_ps(_mm_max_ps(l, vZero), vOne);
+    _mm_storeu_ps(levels + i, _mm_mul_ps(l, vMaster));
+    vPos = _mm_add_epi32(vPos, _mm_set1_epi32(4));
+  }
+#elif __ARM_NEON && __aarch64__
+  const float32x4_t vLast = vdupq_n_f32(last);
+  const float32x4_t vNext = vdupq_n_f32(next);
+  const float32x4_t vMaster = vdupq_n_f32(master);
+  const float32x4_t vInterval = vdupq_n_f32(float(interval));
+  const float32x4_t vZero = vdupq_n_f32(0.f);
+  const float32x4_t vOne = vdupq_n_f32(1.f);
+  const uint32_t lanes[4] = {0, 1, 2, 3};
+  uint32x4_t vPos = vaddq_u32(vdupq_n_u32(pos), vld1q_u32(lanes));
+  for (; i + 4 <= count; i += 4) {
+    const float32x4_t t = vdivq_f32(vcvtq_f32_u32(vPos), vInterval);
+    float32x4_t l = vaddq_f32(vmulq_f32(vLast, vsubq_f32(vOne, t)), vmulq_f32(vNext, t));
+    l = vminq_f32(vmaxq_f32(l, vZero), vOne);
+    vst1q_f32(levels + i, vmulq_f32(l, vMaster));
+    vPos = vaddq_u32(vPos, vdupq_n_u32(4));
+  }
+#endif
+  for (; i < count; ++i) {
+    const float t = (pos + i) / float(interval);
+    const float l = std::clamp(last * (1.f - t) + next * t, 0.f, 1.f);
+    levels[i] = l * master;
+  }
 }
 
-template <typename T>
-T Voice::_procSampleAuxA(double time, T samp) {
-  float evalVol = m_state.m_volumeSel ? (m_state.m_volumeSel.evaluate(time, *this, m_state) / 127.f) : 1.f;
-  evalVol *= m_state.m_reverbSel ? (m_state.m_reverbSel.evaluate(time, *this, m_state) / 127.f) : m_curReverbVol;
-  evalVol += m_state.m_preAuxASel ? (m_state.m_preAuxASel.evaluate(time, *this, m_state) / 127.f) : 0.f;
-  return ApplyVolume(m_auxACache.getVolume(std::clamp(evalVol, 0.f, 1.f), m_dlsVol), samp);
+/* Scales samples by linear gains, truncating toward zero like the scalar `samp * vol` conversion */
+static void ApplyGains(int16_t* samps, const float* gains, uint32_t count) {
+  uint32_t i = 0;
+#if __SSE2__
+  for (; i + 8 <= count; i += 8) {
+    const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samps + i));
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+    const __m128i outLo = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(lo), _mm_loadu_ps(gains + i)));
+    const __m128i outHi = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(hi), _mm_loadu_ps(gains + i + 4)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(samps + i), _mm_packs_epi32(outLo, outHi));
+  }
+#elif __ARM_NEON
+  for (; i + 8 <= count; i += 8) {
+    const int16x8_t s = vld1q_s16(samps + i);
+    const int32x4_t outLo =
+        vcvtq_s32_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), vld1q_f32(gains + i)));
+    const int32x4_t outHi =
+        vcvtq_s32_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), vld1q_f32(gains + i + 4)));
+    vst1q_s16(samps + i, vcombine_s16(vqmovn_s32(outLo), vqmovn_s32(outHi)));
+  }
+#endif
+  for (; i < count; ++i)
+    samps[i] = ApplyVolume(gains[i], samps[i]);
+}
+
+void Voice::_procSamplesPre(int16_t* samps, uint32_t count) {
+  /* Amplitude is resolved at control rate and ramped linearly in between.
+   * Block linearized reproduces the legacy 160-sample lerp exactly (including the
+   * control-point sample taking the new level); per-sample mode ramps over a much
+   * shorter interval, landing on each newly computed level. */
+  const bool linearized = m_engine.m_ampMode == AmplitudeMode::BlockLinearized;
+  const uint32_t interval = linearized ? LinearizedControlInterval : PerSampleControlInterval;
+  const uint32_t posOffset = linearized ? 0 : 1;
+  float gains[LinearizedControlInterval];
+
+  while (count) {
+    const uint32_t rem = m_voiceSamples % interval;
+    if (rem == 0)
+      _advanceAmplitude(interval);
+
+    const uint32_t n = std::min(count, interval - rem);
+    RampLevels(gains, n, rem + posOffset, interval, m_lastLevel, m_nextLevel, m_engine.m_masterVolume);
+    if (linearized && rem == 0)
+      gains[0] = m_nextLevel * m_engine.m_masterVolume;
+
+    /* Map total volume to decibel scale */
+    if (m_dlsVol)
+      LookupDLSVolumeBlock(gains, n);
+    else
+      LookupVolumeBlock(gains, n);
+
+    ApplyGains(samps, gains, n);
+
+    m_voiceSamples += n;
+    samps += n;
+    count -= n;
+  }
+}
+
+void Voice::_evaluateBusGains(std::array<float, 3>& gains) {
+  /* Single pass over the selectors shared by all three buses */
+  const float evalVol = m_state.m_volumeSel ? (m_state.m_volumeSel.evaluate(*this, m_state) / 127.f) : 1.f;
+  const float evalReverb =
+      m_state.m_reverbSel ? (m_state.m_reverbSel.evaluate(*this, m_state) / 127.f) : m_curReverbVol;
+  const float evalPreAuxA = m_state.m_preAuxASel ? (m_state.m_preAuxASel.evaluate(*this, m_state) / 127.f) : 0.f;
+  const float evalPostAuxB =
+      m_state.m_postAuxB ? (m_state.m_postAuxB.evaluate(*this, m_state) / 127.f) : m_curAuxBVol;
+  const float evalPreAuxB = m_state.m_preAuxBSel ? (m_state.m_preAuxBSel.evaluate(*this, m_state) / 127.f) : 0.f;
+
+  gains[0] = m_masterCache.getVolume(std::clamp(evalVol, 0.f, 1.f), m_dlsVol);
+  gains[1] = m_auxACache.getVolume(std::clamp(evalVol * evalReverb + evalPreAuxA, 0.f, 1.f), m_dlsVol);
+  gains[2] = m_auxBCache.getVolume(std::clamp(evalVol * evalPostAuxB + evalPreAuxB, 0.f, 1.f), m_dlsVol);
+}
+
+void Voice::_prepareBusGains() {
+  if (m_busGainsValid)
+    return;
+  m_busGainsValid = true;
+
+  /* Selectors are evaluated once per block at the block's end; those reading just controllers
+   * or variables cannot change within a block, so only LFO-driven sends ramp from the
+   * previous block's end point */
+  m_busGainsStart = m_busGainsEnd;
+  _evaluateBusGains(m_busGainsEnd);
+  if (!m_busGainsPrimed ||
+      !(m_state.m_volumeSel.isTimeVarying() || m_state.m_reverbSel.isTimeVarying() ||
+        m_state.m_preAuxASel.isTimeVarying() || m_state.m_postAuxB.isTimeVarying() ||
+        m_state.m_preAuxBSel.isTimeVarying()))
+    m_busGainsStart = m_busGainsEnd;
+  m_busGainsPrimed = true;
 }
 
 template <typename T>
-T Voice::_procSampleAuxB(double time, T samp) {
-  float evalVol = m_state.m_volumeSel ? (m_state.m_volumeSel.evaluate(time, *this, m_state) / 127.f) : 1.f;
-  evalVol *= m_state.m_postAuxB ? (m_state.m_postAuxB.evaluate(time, *this, m_state) / 127.f) : m_curAuxBVol;
-  evalVol += m_state.m_preAuxBSel ? (m_state.m_preAuxBSel.evaluate(time, *this, m_state) / 127.f) : 0.f;
-  return ApplyVolume(m_auxBCache.getVolume(std::clamp(evalVol, 0.f, 1.f), m_dlsVol), samp);
+void Voice::_routeAudio(size_t frames, int busId, const T* in, T* out) {
+  ProfileScope prof(m_routeTime);
+  _prepareBusGains();
+
+  const size_t bus = (busId == 1 || busId == 2) ? size_t(busId) : 0;
+  const float start = m_busGainsStart[bus];
+  const float step = frames ? (m_busGainsEnd[bus] - start) / float(frames) : 0.f;
+  if (step == 0.f) {
+    for (size_t i = 0; i < frames; ++i)
+      out[i] = ApplyVolume(start, in[i]);
+  } else {
+    for (size_t i = 0; i < frames; ++i)
+      out[i] = ApplyVolume(start + step * float(i), in[i]);
+  }
 }
 
 uint32_t Voice::_GetBlockSampleCount(SampleFormat fmt) {
@@ -322,29 +489,25 @@ uint32_t Voice::_GetBlockSampleCount(SampleFormat fmt) {
   }
 }
 
-static float TriangleWave(float t) {
-  t = std::fmod(t, 1.f);
-  if (t < 0.25f)
-    return t / 0.25f;
-  if (t >= 0.75f)
-    return (t - 0.75f) / 0.25f - 1.f;
-  return (t - 0.25f) / 0.5f * -2.f + 1.f;
-}
-
 void Voice::preSupplyAudio(double dt) {
+  ProfileScope prof(m_preSupplyTime);
+
   /* Process SoundMacro; bootstrapping sample if needed */
   bool dead = m_state.advance(*this, dt);
 
+  m_ageCount = std::max(0.f, m_ageCount - m_ageSpeed * float(dt));
+  m_busGainsValid = false;
+
   /* Process per-block evaluators here */
   if (m_state.m_pedalSel) {
-    bool pedal = m_state.m_pedalSel.evaluate(m_voiceTime, *this, m_state) >= 64.f;
+    bool pedal = m_state.m_pedalSel.evaluate(*this, m_state) >= 64.f;
     if (pedal != m_sustained)
       setPedal(pedal);
   }
 
   bool panDirty = false;
   if (m_state.m_panSel) {
-    float evalPan = (m_state.m_panSel.evaluate(m_voiceTime, *this, m_state) - 64.f) / 63.f;
+    float evalPan = (m_state.m_panSel.evaluate(*this, m_state) - 64.f) / 63.f;
     evalPan = std::clamp(evalPan, -1.f, 1.f);
     if (evalPan != m_curPan) {
       m_curPan = evalPan;
@@ -352,7 +515,7 @@ void Voice::preSupplyAudio(double dt) {
     }
   }
   if (m_state.m_spanSel) {
-    float evalSpan = (m_state.m_spanSel.evaluate(m_voiceTime, *this, m_state) - 64.f) / 63.f;
+    float evalSpan = (m_state.m_spanSel.evaluate(*this, m_state) - 64.f) / 63.f;
     evalSpan = std::clamp(evalSpan, -1.f, 1.f);
     if (evalSpan != m_curSpan) {
       m_curSpan = evalSpan;
@@ -363,7 +526,7 @@ void Voice::preSupplyAudio(double dt) {
     _setPan(m_curPan);
 
   if (m_state.m_pitchWheelSel) {
-    const float evalPWheel = (m_state.m_pitchWheelSel.evaluate(m_voiceTime, *this, m_state) - 64.f) / 63.f;
+    const float evalPWheel = (m_state.m_pitchWheelSel.evaluate(*this, m_state) - 64.f) / 63.f;
     _setPitchWheel(std::clamp(evalPWheel, -1.f, 1.f));
   }
 
@@ -421,9 +584,9 @@ void Voice::preSupplyAudio(double dt) {
   }
 
   /* Process vibrato */
-  if (m_vibratoTime >= 0.f) {
-    m_vibratoTime += dt;
-    float vibrato = TriangleWave(m_vibratoTime / m_vibratoPeriod);
+  if (m_vibrato.isActive()) {
+    m_vibrato.advance(dt);
+    float vibrato = m_vibrato.triangle();
     if (m_vibratoModWheel) {
       int32_t range = m_vibratoModLevel ? m_vibratoModLevel : m_vibratoLevel;
       newPitch += range * vibrato * (m_state.m_curMod / 127.f);
@@ -463,13 +626,72 @@ void Voice::preSupplyAudio(double dt) {
       m_messageTrap.macroId == 0xffff && (!m_curSample || (m_curSample && m_volAdsr.isComplete(*this)))) {
     m_voxState = VoiceState::Dead;
     m_backendVoice->stop();
+  } else if (_isStolen() && (m_stealFade == 0.f || !m_curSample) && m_voxState != VoiceState::Dead) {
+    /* Steal fade-out complete (or nothing audible to fade) */
+    m_voxState = VoiceState::Dead;
+    m_backendVoice->stop();
+  }
+}
+
+bool Voice::_updateVirtual() {
+  /* The first block always decodes so attacks ramping up from silence are never skipped */
+  const float threshold = m_engine.m_virtualThreshold;
+  const bool virt = threshold >= 0.f && m_voiceSamples &&
+                    std::max(m_lastLevel, m_nextLevel) * m_engine.m_masterVolume * m_channelGain <= threshold;
+
+  /* Re-realize at the current position; VADPCM and PCM frames decode without carried state */
+  if (m_virtual && !virt && m_curFormat == SampleFormat::DSP)
+    m_curSample->seekDSPState(m_curSampleData, m_curSamplePos, &m_prev1, &m_prev2);
+
+  m_virtual = virt;
+  return virt;
+}
+
+void Voice::_advanceVirtual(uint32_t samples) {
+  /* Amplitude control points still run so envelopes, tremolo and steal fades progress as if audible */
+  const uint32_t interval =
+      m_engine.m_ampMode == AmplitudeMode::BlockLinearized ? LinearizedControlInterval : PerSampleControlInterval;
+  for (uint32_t count = samples; count;) {
+    const uint32_t rem = m_voiceSamples % interval;
+    if (rem == 0)
+      _advanceAmplitude(interval);
+    const uint32_t n = std::min(count, interval - rem);
+    m_voiceSamples += n;
+    count -= n;
+  }
+
+  /* Move through the sample (and its loop) without touching the codec */
+  while (samples) {
+    const uint32_t n = std::min(samples, m_lastSamplePos - std::min(m_curSamplePos, m_lastSamplePos));
+    m_curSamplePos += n;
+    samples -= n;
+
+    bool looped;
+    if (_checkSamplePos(looped))
+      return;
+    if (looped && m_curSamplePos >= m_lastSamplePos)
+      return;
   }
 }
 
 size_t Voice::supplyAudio(size_t samples, int16_t* data) {
+  if (m_startOffset > 0.0) {
+    /* Hold off until the starting event's position within the first block */
+    const size_t delay = std::min(samples, size_t(m_startOffset * m_sampleRate));
+    m_startOffset = 0.0;
+    memset(data, 0, sizeof(int16_t) * delay);
+    if (delay < samples)
+      supplyAudio(samples - delay, data + delay);
+    return samples;
+  }
+
+  ProfileScope prof(m_supplyTime);
   uint32_t samplesRem = samples;
 
-  if (m_curSample) {
+  if (m_curSample && _updateVirtual()) {
+    _advanceVirtual(samples);
+    memset(data, 0, sizeof(int16_t) * samples);
+  } else if (m_curSample) {
     uint32_t blockSampleCount = _GetBlockSampleCount(m_curFormat);
     uint32_t block;
 
@@ -484,14 +706,18 @@ size_t Voice::supplyAudio(size_t samples, int16_t* data) {
 
         switch (m_curFormat) {
         case SampleFormat::DSP: {
-          decSamples =
-              DSPDecompressFrameRanged(data, m_curSampleData + 8 * block, m_curSample->m_ADPCMParms.dsp.m_coefs,
-                                       &m_prev1, &m_prev2, rem, remCount);
+          decSamples = DSPDecompressFramesRanged(data, m_curSampleData + 8 * block,
+                                                 m_curSample->m_ADPCMParms.dsp.m_coefs, &m_prev1, &m_prev2, rem,
+                                                 std::min(rem + samplesRem, m_lastSamplePos - block * 14));
           break;
         }
         case SampleFormat::N64: {
-          decSamples = N64MusyXDecompressFrameRanged(data, m_curSampleData + 256 + 40 * block,
-                                                     m_curSample->m_ADPCMParms.vadpcm.m_coefs, rem, remCount);
+          if (m_curSample->m_vadpcmPredictor)
+            decSamples = N64MusyXDecompressFrameRanged(data, m_curSampleData + 256 + 40 * block,
+                                                       *m_curSample->m_vadpcmPredictor, rem, remCount);
+          else
+            decSamples = N64MusyXDecompressFrameRanged(data, m_curSampleData + 256 + 40 * block,
+                                                       m_curSample->m_ADPCMParms.vadpcm.m_coefs, rem, remCount);
           break;
         }
         case SampleFormat::PCM: {
@@ -514,11 +740,9 @@ size_t Voice::supplyAudio(size_t samples, int16_t* data) {
           return samples;
         }
 
-        /* Per-sample processing */
-        for (uint32_t i = 0; i < decSamples; ++i) {
-          ++m_curSamplePos;
-          _procSamplePre(data[i]);
-        }
+        /* Block amplitude processing */
+        m_curSamplePos += decSamples;
+        _procSamplesPre(data, decSamples);
 
         samplesRem -= decSamples;
         data += decSamples;
@@ -539,13 +763,17 @@ size_t Voice::supplyAudio(size_t samples, int16_t* data) {
 
         switch (m_curFormat) {
         case SampleFormat::DSP: {
-          decSamples = DSPDecompressFrame(data, m_curSampleData + 8 * block, m_curSample->m_ADPCMParms.dsp.m_coefs,
-                                          &m_prev1, &m_prev2, remCount);
+          decSamples = DSPDecompressFrames(data, m_curSampleData + 8 * block, m_curSample->m_ADPCMParms.dsp.m_coefs,
+                                           &m_prev1, &m_prev2, remCount);
           break;
         }
         case SampleFormat::N64: {
-          decSamples = N64MusyXDecompressFrame(data, m_curSampleData + 256 + 40 * block,
-                                               m_curSample->m_ADPCMParms.vadpcm.m_coefs, remCount);
+          if (m_curSample->m_vadpcmPredictor)
+            decSamples = N64MusyXDecompressFrame(data, m_curSampleData + 256 + 40 * block,
+                                                 *m_curSample->m_vadpcmPredictor, remCount);
+          else
+            decSamples = N64MusyXDecompressFrame(data, m_curSampleData + 256 + 40 * block,
+                                                 m_curSample->m_ADPCMParms.vadpcm.m_coefs, remCount);
           break;
         }
         case SampleFormat::PCM: {
@@ -568,11 +796,9 @@ size_t Voice::supplyAudio(size_t samples, int16_t* data) {
           return samples;
         }
 
-        /* Per-sample processing */
-        for (uint32_t i = 0; i < decSamples; ++i) {
-          ++m_curSamplePos;
-          _procSamplePre(data[i]);
-        }
+        /* Block amplitude processing */
+        m_curSamplePos += decSamples;
+        _procSamplesPre(data, decSamples);
 
         samplesRem -= decSamples;
         data += decSamples;
@@ -598,72 +824,15 @@ size_t Voice::supplyAudio(size_t samples, int16_t* data) {
 }
 
 void Voice::routeAudio(size_t frames, double dt, int busId, int16_t* in, int16_t* out) {
-  dt /= double(frames);
-
-  switch (busId) {
-  case 0:
-  default: {
-    for (uint32_t i = 0; i < frames; ++i)
-      out[i] = _procSampleMaster(dt * i + m_voiceTime, in[i]);
-    break;
-  }
-  case 1: {
-    for (uint32_t i = 0; i < frames; ++i)
-      out[i] = _procSampleAuxA(dt * i + m_voiceTime, in[i]);
-    break;
-  }
-  case 2: {
-    for (uint32_t i = 0; i < frames; ++i)
-      out[i] = _procSampleAuxB(dt * i + m_voiceTime, in[i]);
-    break;
-  }
-  }
+  _routeAudio(frames, busId, in, out);
 }
 
 void Voice::routeAudio(size_t frames, double dt, int busId, int32_t* in, int32_t* out) {
-  dt /= double(frames);
-
-  switch (busId) {
-  case 0:
-  default: {
-    for (uint32_t i = 0; i < frames; ++i)
-      out[i] = _procSampleMaster(dt * i + m_voiceTime, in[i]);
-    break;
-  }
-  case 1: {
-    for (uint32_t i = 0; i < frames; ++i)
-      out[i] = _procSampleAuxA(dt * i + m_voiceTime, in[i]);
-    break;
-  }
-  case 2: {
-    for (uint32_t i = 0; i < frames; ++i)
-      out[i] = _procSampleAuxB(dt * i + m_voiceTime, in[i]);
-    break;
-  }
-  }
+  _routeAudio(frames, busId, in, out);
 }
 
 void Voice::routeAudio(size_t frames, double dt, int busId, float* in, float* out) {
-  dt /= double(frames);
-
-  switch (busId) {
-  case 0:
-  default: {
-    for (uint32_t i = 0; i < frames; ++i)
-      out[i] = _procSampleMaster(dt * i + m_voiceTime, in[i]);
-    break;
-  }
-  case 1: {
-    for (uint32_t i = 0; i < frames; ++i)
-      out[i] = _procSampleAuxA(dt * i + m_voiceTime, in[i]);
-    break;
-  }
-  case 2: {
-    for (uint32_t i = 0; i < frames; ++i)
-      out[i] = _procSampleAuxB(dt * i + m_voiceTime, in[i]);
-    break;
-  }
-  }
+  _routeAudio(frames, busId, in, out);
 }
 
 int Voice::maxVid() const {
@@ -674,8 +843,11 @@ int Voice::maxVid() const {
 }
 
 ObjToken<Voice> Voice::_startChildMacro(ObjectId macroId, int macroStep, double ticksPerSec, uint8_t midiKey,
-                                        uint8_t midiVel, uint8_t midiMod, bool pushPc) {
-  std::list<ObjToken<Voice>>::iterator vox = _allocateVoice(NativeSampleRate, true);
+                                        uint8_t midiVel, uint8_t midiMod, uint8_t priority, uint8_t maxVoices,
+                                        const void* limitTag, bool pushPc) {
+  std::list<ObjToken<Voice>>::iterator vox = _allocateVoice(NativeSampleRate, true, priority, maxVoices, limitTag);
+  if (vox == m_childVoices.end())
+    return {};
   if (!(*vox)->loadMacroObject(macroId, macroStep, ticksPerSec, midiKey, midiVel, midiMod, pushPc)) {
     _destroyVoice(vox);
     return {};
@@ -688,9 +860,10 @@ ObjToken<Voice> Voice::_startChildMacro(ObjectId macroId, int macroStep, double
   return *vox;
 }
 
-ObjToken<Voice> Voice::startChildMacro(int8_t addNote, ObjectId macroId, int macroStep) {
+ObjToken<Voice> Voice::startChildMacro(int8_t addNote, ObjectId macroId, int macroStep, uint8_t priority,
+                                       uint8_t maxVoices, const void* limitTag) {
   return _startChildMacro(macroId, macroStep, 1000.0, m_state.m_initKey + addNote, m_state.m_initVel,
-                          m_state.m_initMod);
+                          m_state.m_initMod, priority, maxVoices, limitTag);
 }
 
 bool Voice::_loadSoundMacro(SoundMacroId id, const SoundMacro* macroData, int macroStep, double ticksPerSec,
@@ -737,7 +910,8 @@ bool Voice::_loadLayer(const std::vector<LayerMapping>& layer, double ticksPerSe
         _setPan((mapping.pan - 64) / 64.f);
         _setSurroundPan((mapping.span - 64) / 64.f);
       } else {
-        ObjToken<Voice> vox = _startChildMacro(mapping.macro.id, 0, ticksPerSec, mappingKey, midiVel, midiMod, pushPc);
+        ObjToken<Voice> vox = _startChildMacro(mapping.macro.id, 0, ticksPerSec, mappingKey, midiVel, midiMod,
+                                               m_priority, 0, nullptr, pushPc);
         if (vox) {
           vox->m_curUserVol = vox->m_targetUserVol = mapping.volume / 127.f;
           vox->_setPan((mapping.pan - 64) / 64.f);
@@ -869,6 +1043,13 @@ void Voice::startSample(SampleId sampId, int32_t offset) {
     if (m_curFormat == SampleFormat::DSP_DRUM)
       m_curFormat = SampleFormat::DSP;
 
+    /* Play from resident decoded PCM when the engine caches this sample */
+    m_curDecoded = m_engine.m_sampleCache.lookup(m_audioGroup, sampId, m_curSample, m_curSampleData);
+    if (m_curDecoded) {
+      m_curSampleData = reinterpret_cast<const unsigned char*>(m_curDecoded->m_pcm.get());
+      m_curFormat = SampleFormat::PCM_PC;
+    }
+
     m_lastSamplePos =
         m_curSample->isLooped() ? (m_curSample->m_loopStartSample + m_curSample->m_loopLengthSamples) : numSamples;
     if (m_lastSamplePos)
@@ -878,21 +1059,15 @@ void Voice::startSample(SampleId sampId, int32_t offset) {
     _checkSamplePos(looped);
 
     /* Seek DSPADPCM state if needed */
-    if (m_curSample && m_curSamplePos && m_curFormat == SampleFormat::DSP) {
-      uint32_t block = m_curSamplePos / 14;
-      uint32_t rem = m_curSamplePos % 14;
-      for (uint32_t b = 0; b < block; ++b)
-        DSPDecompressFrameStateOnly(m_curSampleData + 8 * b, m_curSample->m_ADPCMParms.dsp.m_coefs, &m_prev1, &m_prev2,
-                                    14);
-
-      if (rem)
-        DSPDecompressFrameStateOnly(m_curSampleData + 8 * block, m_curSample->m_ADPCMParms.dsp.m_coefs, &m_prev1,
-                                    &m_prev2, rem);
-    }
+    if (m_curSample && m_curSamplePos && m_curFormat == SampleFormat::DSP)
+      m_curSample->seekDSPState(m_curSampleData, m_curSamplePos, &m_prev1, &m_prev2);
   }
 }
 
-void Voice::stopSample() { m_curSample.reset(); }
+void Voice::stopSample() {
+  m_curSample.reset();
+  m_curDecoded.reset();
+}
 
 void Voice::setVolume(float vol) {
   if (m_destroyed)
@@ -1053,6 +1228,7 @@ void Voice::setSurroundPan(float span) {
 }
 
 void Voice::_setChannelCoefs(const std::array<float, 8>& coefs) {
+  m_channelGain = *std::max_element(coefs.cbegin(), coefs.cend());
   m_backendVoice->setChannelLevels(m_studio->getMaster().m_backendSubmix.get(), coefs, true);
   m_backendVoice->setChannelLevels(m_studio->getAuxA().m_backendSubmix.get(), coefs, true);
   m_backendVoice->setChannelLevels(m_studio->getAuxB().m_backendSubmix.get(), coefs, true);
@@ -1113,10 +1289,10 @@ void Voice::setPedal(bool pedal) {
 void Voice::setDoppler(float) {}
 
 void Voice::setVibrato(int32_t level, bool modScale, float period) {
-  m_vibratoTime = std::fabs(period) < FLT_EPSILON ? -1.f : 0.f;
+  m_vibrato.setPeriod(period);
+  m_vibrato.reset();
   m_vibratoLevel = level;
   m_vibratoModWheel = modScale;
-  m_vibratoPeriod = period;
 }
 
 void Voice::setMod2VibratoRange(int32_t modLevel) { m_vibratoModLevel = modLevel; }
@@ -1259,7 +1435,7 @@ bool Voice::doPortamento(uint8_t newNote) {
     pState = true;
     break;
   case SoundMacro::CmdPortamento::PortState::MIDIControlled:
-    pState = m_state.m_portamentoSel ? (m_state.m_portamentoSel.evaluate(m_voiceTime, *this, m_state) >= 64.f)
+    pState = m_state.m_portamentoSel ? (m_state.m_portamentoSel.evaluate(*this, m_state) >= 64.f)
                                      : (getCtrlValue(65) >= 64);
     break;
   }
@@ -0,0 +1,101 @@
+#include "amuse/VoicePool.hpp"
+
+#include <algorithm>
+#include <new>
+
+#include "amuse/Voice.hpp"
+
+namespace amuse {
+
+static_assert(alignof(Voice) <= VoicePool::SlotAlign, "Voice alignment exceeds pool slot alignment");
+
+void VoicePool::StorageDeleter::operator()(unsigned char* ptr) const {
+  ::operator delete[](ptr, std::align_val_t(SlotAlign));
+}
+
+VoicePool::VoicePool(size_t capacity)
+: m_capacity(capacity)
+, m_slotStride(HeaderSize + ((sizeof(Voice) + SlotAlign - 1) & ~(SlotAlign - 1)))
+, m_storage(static_cast<unsigned char*>(::operator new[](m_slotStride * capacity, std::align_val_t(SlotAlign)))) {
+  /* Thread slots onto the free list in address order */
+  for (size_t i = capacity; i > 0; --i) {
+    auto* header = new (m_storage.get() + m_slotStride * (i - 1)) SlotHeader;
+    header->m_pool = this;
+    header->m_pcSpare.reserve(4);
+    header->m_nextFree = m_freeHead.load(std::memory_order_relaxed);
+    m_freeHead.store(header, std::memory_order_relaxed);
+  }
+  m_freeNodes.resize(capacity);
+}
+
+VoicePool::~VoicePool() {
+  /* Every voice holds a reference to its pool, so all slots are free at this point */
+  for (size_t i = 0; i < m_capacity; ++i)
+    reinterpret_cast<SlotHeader*>(m_storage.get() + m_slotStride * i)->~SlotHeader();
+}
+
+void* VoicePool::allocate(size_t sz) {
+  /* Only the engine thread pops, so a concurrent push cannot cause ABA on the head */
+  SlotHeader* header = m_freeHead.load(std::memory_order_acquire);
+  while (header &&
+         !m_freeHead.compare_exchange_weak(header, header->m_nextFree, std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {}
+  if (!header) {
+    ++m_numRefused;
+    return nullptr;
+  }
+
+  increment();
+  m_peakInUse = std::max(m_peakInUse, m_numInUse.fetch_add(1, std::memory_order_relaxed) + 1);
+  return reinterpret_cast<unsigned char*>(header) + HeaderSize;
+}
+
+void VoicePool::_free(SlotHeader* header) {
+  SlotHeader* head = m_freeHead.load(std::memory_order_relaxed);
+  do {
+    header->m_nextFree = head;
+  } while (!m_freeHead.compare_exchange_weak(head, header, std::memory_order_release, std::memory_order_relaxed));
+  m_numInUse.fetch_sub(1, std::memory_order_relaxed);
+  decrement();
+}
+
+void* VoicePool::AllocateHeap(size_t sz) {
+  auto* block = static_cast<unsigned char*>(::operator new(HeaderSize + sz, std::align_val_t(SlotAlign)));
+  new (block) SlotHeader;
+  return block + HeaderSize;
+}
+
+void VoicePool::Deallocate(void* obj) {
+  SlotHeader* header = HeaderOf(obj);
+  if (header->m_pool) {
+    header->m_pool->_free(header);
+    return;
+  }
+  header->~SlotHeader();
+  ::operator delete(header, std::align_val_t(SlotAlign));
+}
+
+std::list<ObjToken<Voice>>::iterator VoicePool::linkVoice(std::list<ObjToken<Voice>>& list, ObjToken<Voice> vox) {
+  if (m_freeNodes.empty())
+    return list.emplace(list.end(), std::move(vox));
+  list.splice(list.end(), m_freeNodes, m_freeNodes.begin());
+  auto it = std::prev(list.end());
+  *it = std::move(vox);
+  return it;
+}
+
+std::list<ObjToken<Voice>>::iterator VoicePool::unlinkVoice(std::list<ObjToken<Voice>>& list,
+                                                            std::list<ObjToken<Voice>>::iterator it) {
+  auto next = std::next(it);
+  m_freeNodes.splice(m_freeNodes.begin(), list, it);
+  it->reset();
+  return next;
+}
+
+void VoicePool::unlinkAll(std::list<ObjToken<Voice>>& list) {
+  for (ObjToken<Voice>& vox : list)
+    vox.reset();
+  m_freeNodes.splice(m_freeNodes.begin(), list);
+}
+
+} // namespace amuse
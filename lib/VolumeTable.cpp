@@ -64,4 +64,21 @@ float LookupDLSVolume(float vol) {
   return (1.f - t) * DLSVolumeTable[int(f)] + t * DLSVolumeTable[int(c)];
 }
 
+template <const std::array<float, 129>& Table>
+static void LookupVolumeBlockImp(float* vols, size_t count) {
+  /* Branch-free form of the scalar lookup; when floor == ceil the lerp
+   * degenerates to exactly Table[f], so results are bit-identical */
+  for (size_t i = 0; i < count; ++i) {
+    const float vol = std::clamp(vols[i] * 127.f, 0.f, 127.f);
+    const int f = int(vol);
+    const float t = vol - float(f);
+    const int c = f + (t > 0.f);
+    vols[i] = (1.f - t) * Table[f] + t * Table[c];
+  }
+}
+
+void LookupVolumeBlock(float* vols, size_t count) { LookupVolumeBlockImp<VolumeTable>(vols, count); }
+
+void LookupDLSVolumeBlock(float* vols, size_t count) { LookupVolumeBlockImp<DLSVolumeTable>(vols, count); }
+
 } // namespace amuse